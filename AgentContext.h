@@ -0,0 +1,103 @@
+#ifndef AGENT_CONTEXT_H
+#define AGENT_CONTEXT_H
+
+#include "GameBoard.h"
+#include "BoardView.h"
+#include "BitBoard.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class AgentContext
+     * Everything an agent may look at while choosing one move
+     *
+     * The short range scan is always filled in. The long range scan has to be asked for,
+     * and each robot may do so at most LONG_RANGE_LIMIT times per match; asking again
+     * in the same move is free. The bitboard layers are the whole board too, so they
+     * come out of the same scan. The view behind it is lazy, so an agent that never asks
+     * costs the match nothing beyond the short range scan. A context is only valid
+     * during the getMove call it was passed to.
+     */
+    class AgentContext {
+        public:
+            /**
+             * Bundles the inputs of one move, none of them are owned
+             * @param scansLeft Long range scans the robot has left in the match
+             */
+            AgentContext(RobotMoveRequest::RobotColor robot, GameBoard::ShortRangeScan& srs,
+                         BoardView& longRange, const BitBoard& layers, int scansLeft) :
+                robot(robot),
+                srs(&srs),
+                longRange(&longRange),
+                layers(&layers),
+                scansLeft(scansLeft),
+                scanned(false) {}
+
+            /**
+             * @return color of the robot the move is for
+             */
+            RobotMoveRequest::RobotColor getRobot() const {return robot;}
+
+            /**
+             * Gets the 5*5 view around the robot, facing up
+             */
+            ExternalBoardSquare** shortRangeScan() {return srs->rowPointers();}
+
+            /**
+             * Spends a long range scan on the lazy view of the whole board, read squares
+             * with at()
+             * @return the view, or nullptr once the robot's scans are used up
+             */
+            BoardView* requestLongRangeView() {
+                if (!scanned) {
+                    if (scansLeft <= 0) {
+                        return nullptr;
+                    }
+                    --scansLeft;
+                    scanned = true;
+                }
+                return longRange;
+            }
+
+            /**
+             * Spends a long range scan on the whole board as a jagged array
+             * @return the scan, or nullptr once the robot's scans are used up
+             */
+            ExternalBoardSquare** requestLongRangeScan() {
+                BoardView* view = requestLongRangeView();
+                return view ? view->rows() : nullptr;
+            }
+
+            /**
+             * @return long range scans left in the match, after this move's if it took one
+             */
+            int longRangeScansLeft() const {return scansLeft;}
+
+            /**
+             * @return true if this move spent a long range scan
+             */
+            bool usedLongRangeScan() const {return scanned;}
+
+            /**
+             * Spends a long range scan on the paint, rock, fog and wall layers of the
+             * board, the same one as the view, so asking for both in a move costs one
+             * @return the layers, or nullptr once the robot's scans are used up
+             */
+            const BitBoard* requestLayers() {
+                return requestLongRangeView() ? layers : nullptr;
+            }
+
+        private:
+            RobotMoveRequest::RobotColor robot; // robot moving
+            GameBoard::ShortRangeScan* srs; // view around the robot
+            BoardView* longRange; // lazy view of the board
+            const BitBoard* layers; // bitboard layers of the board
+            int scansLeft; // long range scans the robot may still take
+            bool scanned; // this move already paid for a long range scan
+    };
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "AgentWorker.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * Starts the worker thread idle
+     */
+    AgentWorker::AgentWorker() :
+        state(IDLE),
+        agent(nullptr),
+        robot(RobotMoveRequest::RED),
+        board(nullptr),
+        copied(nullptr),
+        scansLeft(0),
+        scanned(false),
+        elapsed(0),
+        thread(&AgentWorker::run, this) {}
+
+    /**
+     * Asks the thread to exit and joins it, after any getMove still running
+     */
+    AgentWorker::~AgentWorker() {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] {return state != WORKING;});
+            state = STOPPING;
+        }
+        changed.notify_all();
+        thread.join();
+    }
+
+    /**
+     * Copies the inputs and wakes the thread, a late answer to an earlier move is
+     * dropped here. The board is only copied if asked to and it changed since the
+     * last copy, which the version tells
+     */
+    bool AgentWorker::begin(IRobotAgent* agent, RobotMoveRequest::RobotColor robot,
+                            const GameBoard::ShortRangeScan& srs, const GameBoard& board, int scansLeft,
+                            bool copyBoard) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (state == WORKING) {
+                return false;
+            }
+            failure = nullptr;
+            this->agent = agent;
+            this->robot = robot;
+            this->srs = srs;
+            if (!copyBoard) {
+                // Stale layers are rebuilt here, so the thread only ever reads the board
+                board.getBitBoard();
+                this->board = &board;
+            } else {
+                if (!snapshot) {
+                    snapshot.reset(new GameBoard(board));
+                } else if (copied != &board || snapshot->getVersion() != board.getVersion()) {
+                    *snapshot = board;
+                }
+                copied = &board;
+                this->board = snapshot.get();
+            }
+            this->scansLeft = scansLeft;
+            scanned = false;
+            state = WORKING;
+        }
+        changed.notify_all();
+        return true;
+    }
+
+    /**
+     * Waits until the move is ready or the deadline passes
+     */
+    bool AgentWorker::finish(Clock::time_point deadline, RobotMoveRequest& move) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!changed.wait_until(lock, deadline, [this] {return state == DONE;})) {
+            return false;
+        }
+        takeResult(move);
+        return true;
+    }
+
+    /**
+     * Waits without a deadline
+     */
+    void AgentWorker::finish(RobotMoveRequest& move) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] {return state == DONE;});
+        takeResult(move);
+    }
+
+    /**
+     * Drops a finished or overdue move, the next match starts from a fresh copy
+     */
+    void AgentWorker::release() {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] {return state != WORKING;});
+        state = IDLE;
+        failure = nullptr;
+        agent = nullptr;
+        board = nullptr;
+        copied = nullptr;
+    }
+
+    /**
+     * Hands over the finished move, or rethrows what the agent threw
+     */
+    void AgentWorker::takeResult(RobotMoveRequest& move) {
+        state = IDLE;
+        if (failure) {
+            std::exception_ptr thrown = failure;
+            failure = nullptr;
+            std::rethrow_exception(thrown);
+        }
+        move = result;
+    }
+
+    /**
+     * Calls nextMove outside the lock for every move handed over by begin
+     */
+    void AgentWorker::run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            changed.wait(lock, [this] {return state == WORKING || state == STOPPING;});
+            if (state == STOPPING) {
+                return;
+            }
+
+            lock.unlock();
+            RobotMoveRequest move = {};
+            std::exception_ptr thrown;
+            BoardView view(*board, lrs);
+            AgentContext context(robot, srs, view, board->getBitBoard(), scansLeft);
+            Clock::time_point start = Clock::now();
+            try {
+                move = agent->nextMove(context);
+            } catch (...) {
+                thrown = std::current_exception();
+            }
+            Clock::duration took = Clock::now() - start;
+            lock.lock();
+
+            scanned = context.usedLongRangeScan();
+            elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(took).count();
+            result = move;
+            failure = thrown;
+            state = DONE;
+            changed.notify_all();
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef AGENT_WORKER_H
+#define AGENT_WORKER_H
+
+#include "IRobotAgent.h"
+#include "GameBoard.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <exception>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class AgentWorker
+     * Runs agents' moves on a thread of its own, so the caller can stop waiting for
+     * them at a deadline or compute two moves at once
+     *
+     * A worker is not tied to an agent, each move names the agent to call, so one
+     * thread can serve every match a tournament thread or a series plays. The agent
+     * reads the board through a version stamped BoardView. When the caller waits for
+     * every move before changing the board, that is the live board and nothing is
+     * copied. When a deadline can leave an agent running past its turn, the worker
+     * reads a copy instead, refreshed only when the board's version moved on, so an
+     * agent that overruns keeps reading a consistent turn while the match moves on.
+     * Its late answer is thrown away, and until it returns the worker refuses new
+     * moves. A C++ thread cannot be cancelled, so release and the destructor still
+     * wait for a running move to come back.
+     */
+    class AgentWorker {
+        public:
+            typedef std::chrono::steady_clock Clock;
+
+            /**
+             * Starts the thread idle
+             */
+            AgentWorker();
+
+            /**
+             * Stops the thread once the agent is done with its current move
+             */
+            ~AgentWorker();
+
+            /**
+             * Hands an agent the turn to compute a robot's next move from. Neither the
+             * agent nor the board is owned
+             * @param scansLeft Long range scans the robot has left in the match
+             * @param copyBoard Read a copy of the board, for callers that may change the
+             *                  board before the move is finished
+             * @return false if the worker is still busy with an earlier, overdue move
+             */
+            bool begin(IRobotAgent* agent, RobotMoveRequest::RobotColor robot, const GameBoard::ShortRangeScan& srs,
+                       const GameBoard& board, int scansLeft, bool copyBoard);
+
+            /**
+             * Waits for the move started by begin
+             * @param deadline Latest time to wait until
+             * @param move Receives the agent's move, untouched on timeout
+             * @return false if the deadline passed first
+             * @throws whatever the agent's getMove threw
+             */
+            bool finish(Clock::time_point deadline, RobotMoveRequest& move);
+
+            /**
+             * Waits for the move started by begin, however long it takes
+             * @param move Receives the agent's move
+             * @throws whatever the agent's getMove threw
+             */
+            void finish(RobotMoveRequest& move);
+
+            /**
+             * @return true if the move last picked up by finish spent a long range scan
+             */
+            bool usedLongRangeScan() const {return scanned;}
+
+            /**
+             * @return nanoseconds the agent took over the move last picked up by finish,
+             * measured on the worker thread
+             */
+            uint64_t lastMoveNanoseconds() const {return elapsed;}
+
+            /**
+             * Waits out a move still running and forgets the board and the agent, so
+             * both can go away. Call it before a match using the worker ends
+             */
+            void release();
+
+        private:
+            /**
+             * @enum What the worker thread is doing
+             */
+            enum State {
+                IDLE,       // waiting for a move to compute
+                WORKING,    // inside getMove
+                DONE,       // move ready to be picked up
+                STOPPING    // asked to exit
+            };
+
+            std::mutex mutex; // guards everything below
+            std::condition_variable changed; // signalled on every state change
+            State state; // current state
+            IRobotAgent* agent; // agent of the current move
+            RobotMoveRequest::RobotColor robot; // the worker's copy of the inputs
+            GameBoard::ShortRangeScan srs;
+            const GameBoard* board; // board the agent reads, the caller's or snapshot
+            const GameBoard* copied; // board snapshot was last copied from, null if none
+            std::unique_ptr<GameBoard> snapshot; // copy read under a deadline, made on first use
+            GameBoard::LongRangeScan lrs; // filled only if the agent reads the long range view
+            int scansLeft;
+            bool scanned; // the agent spent a long range scan on its move
+            uint64_t elapsed; // nanoseconds the agent took over its move
+            RobotMoveRequest result; // move returned by the agent
+            std::exception_ptr failure; // exception thrown by the agent
+            std::thread thread; // runs the agent, declared last so it starts after the rest
+
+            /**
+             * Thread body, computes moves until stopped
+             */
+            void run();
+
+            /**
+             * Moves the finished result out, the mutex must be held
+             */
+            void takeResult(RobotMoveRequest& move);
+
+            AgentWorker(const AgentWorker&) = delete;
+            AgentWorker& operator = (const AgentWorker&) = delete;
+    };
+}
+
+#endif
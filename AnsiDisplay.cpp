@@ -0,0 +1,192 @@
+#include "AnsiDisplay.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    namespace {
+        const char CLEAR_SCREEN[] = "\x1b[2J";
+        const char RESET_STYLE[] = "\x1b[0m";
+        const char CLEAR_LINE[] = "\x1b[K";
+
+        // Black text on the square's paint, walls dark gray
+        const char RED_STYLE[] = "\x1b[30;41m";
+        const char BLUE_STYLE[] = "\x1b[30;44m";
+        const char WHITE_STYLE[] = "\x1b[30;47m";
+        const char WALL_STYLE[] = "\x1b[30;100m";
+
+        const char FACING_GLYPH[4] = {'^', 'v', '>', '<'}; // NORTH, SOUTH, EAST, WEST
+    }
+
+    /**
+     * Starts without a board, the first update loads one
+     */
+    AnsiDisplay::AnsiDisplay(std::ostream& out) :
+        out(out),
+        trackedBoard(nullptr),
+        stride(0),
+        scanAll(false),
+        drawn(false) {}
+
+    /**
+     * Reads the squares through the long range scan, like PlainDisplay, so fog
+     * hides what it hides there
+     */
+    void AnsiDisplay::loadBoard(const GameBoard* board) {
+        int boardStride = board->getSize() + 2;
+        if (boardStride != stride) {
+            stride = boardStride;
+            current.assign(size_t(stride) * stride, 0);
+            shown.assign(size_t(stride) * stride, 0);
+            pending.reset(stride);
+            drawn = false;
+        }
+        GameBoard::LongRangeScan scan;
+        board->getLongRangeScan(scan);
+        for (int i = 0; i < stride; i++) {
+            for (int j = 0; j < stride; j++) {
+                current[size_t(i) * stride + j] = scan[i][j].packedState();
+            }
+        }
+        trackedBoard = board;
+        scanAll = true;
+    }
+
+    /**
+     * Reloads everything, the notification does not say what changed
+     */
+    void AnsiDisplay::update(Observable* subject) {
+        const GameBoard* board = static_cast<GameBoard*>(subject);
+        if (board) {
+            loadBoard(board);
+        }
+    }
+
+    /**
+     * Keeps the changed squares for the next frame
+     */
+    void AnsiDisplay::update(Observable* subject, const BoardChange& change) {
+        const GameBoard* board = static_cast<GameBoard*>(subject);
+        if (!board) return;
+        if (board != trackedBoard || change.getStride() != stride) {
+            loadBoard(board);
+            return;
+        }
+        change.forEachDirty([&](int row, int col) {
+            current[size_t(row) * stride + col] = ExternalBoardSquare(board->getSquare(row, col)).packedState();
+        });
+        pending.merge(change);
+    }
+
+    /**
+     * Terminal rows and columns count from 1
+     */
+    void AnsiDisplay::moveCursor(int row, int col) {
+        char sequence[32];
+        int length = std::snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", row + 1, col * CELL_WIDTH + 1);
+        frame.append(sequence, length);
+    }
+
+    /**
+     * Walks the changed squares in row order and repaints those that look different
+     * from the screen. The cursor and colors are only set when they differ from where
+     * the previous square left them, and the cursor ends on the line below the board
+     */
+    void AnsiDisplay::display() {
+        frame.clear();
+        if (stride == 0) {
+            return;
+        }
+
+        bool redrawAll = !drawn;
+        if (redrawAll) {
+            frame += CLEAR_SCREEN;
+        }
+        int cursorRow = -1;
+        int cursorCol = -1;
+        const char* style = nullptr;
+        auto drawSquare = [&](int row, int col) {
+            size_t index = size_t(row) * stride + col;
+            if (!redrawAll && current[index] == shown[index]) {
+                return;
+            }
+            if (row != cursorRow || col != cursorCol) {
+                moveCursor(row, col);
+            }
+            const Cell& cell = cellFor(current[index]);
+            if (cell.style != style) {
+                frame += cell.style;
+                style = cell.style;
+            }
+            frame.append(cell.glyph, CELL_WIDTH);
+            shown[index] = current[index];
+            cursorRow = row;
+            cursorCol = col + 1;
+        };
+
+        if (redrawAll || scanAll) {
+            for (int row = 0; row < stride; row++) {
+                for (int col = 0; col < stride; col++) {
+                    drawSquare(row, col);
+                }
+            }
+        } else {
+            pending.forEachDirty(drawSquare);
+        }
+        pending.clear();
+        scanAll = false;
+        drawn = true;
+
+        if (frame.empty()) {
+            return;
+        }
+        frame += RESET_STYLE;
+        moveCursor(stride, 0);
+        frame += CLEAR_LINE;
+        out.write(frame.data(), frame.size());
+        out.flush();
+    }
+
+    /**
+     * Draws every combination of color, type, robots and facing once, indexed by
+     * the packed byte they make up
+     */
+    const AnsiDisplay::Cell& AnsiDisplay::cellFor(uint8_t packedState) {
+        static const std::vector<Cell> cells = [] {
+            std::vector<Cell> table(256);
+            for (int color = 0; color < 4; color++) {
+                for (int type = 0; type < 4; type++) {
+                    for (int facing = 0; facing < 4; facing++) {
+                        for (int robots = 0; robots < 4; robots++) {
+                            BoardSquare square(static_cast<SquareColor>(color), (robots & 1) != 0, (robots & 2) != 0,
+                                               static_cast<Direction>(facing), static_cast<SquareType>(type));
+                            Cell& cell = table[square.packedState()];
+                            switch (square.getSquareColor()) {
+                                case RED: cell.style = RED_STYLE; break;
+                                case BLUE: cell.style = BLUE_STYLE; break;
+                                case WHITE:
+                                default: cell.style = WHITE_STYLE; break;
+                            }
+                            cell.glyph[0] = ' ';
+                            cell.glyph[1] = ' ';
+                            if (square.getSquareType() == WALL) {
+                                cell.style = WALL_STYLE;
+                            } else if (square.redRobotPresent() || square.blueRobotPresent()) {
+                                cell.glyph[0] = square.redRobotPresent() ? 'R' : 'B';
+                                cell.glyph[1] = FACING_GLYPH[square.robotDirection()];
+                            } else if (square.getSquareType() == ROCK) {
+                                cell.glyph[0] = cell.glyph[1] = '#';
+                            } else if (square.getSquareType() == FOG) {
+                                cell.glyph[0] = cell.glyph[1] = '~';
+                            }
+                        }
+                    }
+                }
+            }
+            return table;
+        }();
+        return cells[packedState];
+    }
+}
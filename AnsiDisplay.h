@@ -0,0 +1,103 @@
+#ifndef ANSI_DISPLAY_H
+#define ANSI_DISPLAY_H
+
+#include "ObserverPattern.h"
+#include "GameBoard.h"
+#include "BoardSquare.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class AnsiDisplay
+     * Colored terminal display that redraws only the squares that changed
+     *
+     * Keeps the packed state of every square as last drawn. The first frame clears the
+     * screen and draws the whole board, later frames move the cursor to each square
+     * whose state differs from the drawn one and repaint that square alone, so a turn
+     * costs a few dozen bytes instead of a full board. Squares are two characters wide:
+     * the background shows the paint, robots show as R or B with an arrow for their
+     * facing, rocks as ## and fog as ~~.
+     */
+    class AnsiDisplay : public Observer {
+        public:
+            /**
+             * Writes frames to out, which has to be a terminal that understands ANSI
+             * escape sequences to make sense of them
+             */
+            explicit AnsiDisplay(std::ostream& out = std::cout);
+
+            /**
+             * Reloads every square of the observed board
+             */
+            void update(Observable* subject) override;
+
+            /**
+             * Reloads the changed squares only, everything the first time it sees a board
+             */
+            void update(Observable* subject, const BoardChange& change) override;
+
+            /**
+             * Draws the squares that changed since the last frame with a single write
+             */
+            void display();
+
+            /**
+             * Clears the screen and draws the whole board on the next frame, for when
+             * something else wrote to the terminal
+             */
+            void invalidate() {drawn = false;}
+
+            /**
+             * @return bytes written by the last frame
+             */
+            size_t lastFrameSize() const {return frame.size();}
+
+        private:
+            static const int CELL_WIDTH = 2; // characters per square
+
+            /**
+             * @struct How one packed square state is drawn
+             */
+            struct Cell {
+                const char* style; // escape sequence selecting the colors
+                char glyph[CELL_WIDTH];
+            };
+
+            std::ostream& out; // terminal written to
+            const GameBoard* trackedBoard; // board the squares were last fully loaded from
+            int stride; // rows and columns, walls included
+            std::vector<uint8_t> current; // packed state of every square, row major
+            std::vector<uint8_t> shown; // packed state of every square as on screen
+            BoardChange pending; // squares changed since the last frame
+            bool scanAll; // compare every square on the next frame
+            bool drawn; // whether the screen holds a whole frame of the board
+            std::string frame; // escape sequences of the last frame, reused between frames
+
+            /**
+             * Loads every square of a board, resizing for a board of another size
+             */
+            void loadBoard(const GameBoard* board);
+
+            /**
+             * Appends the sequence moving the cursor to a square
+             */
+            void moveCursor(int row, int col);
+
+            /**
+             * Gets the drawing of every packed square state, built on first use
+             */
+            static const Cell& cellFor(uint8_t packedState);
+
+            AnsiDisplay(const AnsiDisplay&) = delete;
+            AnsiDisplay& operator = (const AnsiDisplay&) = delete;
+    };
+}
+
+#endif
@@ -0,0 +1,166 @@
+#include "AnsiDisplayTest.h"
+#include "AnsiDisplay.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    namespace {
+
+        /**
+         * Builds a seeded board of the given size
+         */
+        GameBoard seededBoard(uint64_t seed, int size = GameBoard::BOARD_SIZE) {
+            Config config;
+            config.setSeed(seed);
+            config.setBoardSize(size);
+            return GameBoard(config);
+        }
+
+        /**
+         * Counts the occurrences of a sequence in a frame
+         */
+        size_t countOf(const std::string& frame, const std::string& sequence) {
+            size_t count = 0;
+            for (size_t at = frame.find(sequence); at != std::string::npos; at = frame.find(sequence, at + 1)) {
+                ++count;
+            }
+            return count;
+        }
+
+        /**
+         * Gets the sequence moving the cursor to a square
+         */
+        std::string cursorTo(int row, int col) {
+            return "\x1b[" + std::to_string(row + 1) + ";" + std::to_string(col * 2 + 1) + "H";
+        }
+    }
+
+    /**
+     * @test Testing that the first frame draws the whole board and an unchanged board
+     * draws nothing
+     */
+    void AnsiDisplayTest::testFirstFrame() {
+        GameBoard board = seededBoard(31);
+        std::ostringstream terminal;
+        AnsiDisplay display(terminal);
+        display.display();
+        assert(terminal.str().empty());
+
+        display.update(&board);
+        display.display();
+        std::string frame = terminal.str();
+        assert(frame.compare(0, 4, "\x1b[2J") == 0);
+        assert(display.lastFrameSize() == frame.size());
+        int stride = board.getSize() + 2;
+        assert(countOf(frame, "R") + countOf(frame, "B") >= 2);
+        assert(frame.find(cursorTo(stride, 0)) != std::string::npos);
+
+        // Nothing changed, nothing written
+        terminal.str("");
+        display.display();
+        assert(terminal.str().empty());
+        assert(display.lastFrameSize() == 0);
+
+        // Invalidating draws everything again
+        display.invalidate();
+        display.display();
+        assert(terminal.str() == frame);
+        std::cout << "First frame test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a turn costs a few dozen bytes, sent only for changed squares
+     */
+    void AnsiDisplayTest::testChangedSquaresOnly() {
+        GameBoard board = seededBoard(32);
+        std::ostringstream terminal;
+        AnsiDisplay display(terminal);
+        board.addObserver(&display);
+        display.update(&board);
+        display.display();
+        size_t fullFrame = display.lastFrameSize();
+
+        int redRow = 0;
+        int redCol = 0;
+        for (int row = 1; row <= board.getSize(); ++row) {
+            for (int col = 1; col <= board.getSize(); ++col) {
+                if (board.getSquare(row, col).redRobotPresent()) {
+                    redRow = row;
+                    redCol = col;
+                }
+            }
+        }
+        assert(redRow != 0);
+
+        RobotMoveRequest request = {RobotMoveRequest::RED, RobotMoveRequest::ROTATERIGHT, false};
+        {
+            GameBoard::Turn turn(board);
+            assert(board.moveRobot(request));
+            turn.commit();
+        }
+        terminal.str("");
+        display.display();
+        std::string frame = terminal.str();
+        assert(frame.find("\x1b[2J") == std::string::npos);
+        assert(countOf(frame, "\x1b[") == 5); // cursor, colors, reset, cursor below the board, clear line
+        assert(frame.find(cursorTo(redRow, redCol)) == 0);
+        assert(frame.find(std::string("R") + "^v><"[board.getSquare(redRow, redCol).robotDirection()]) != std::string::npos);
+        assert(frame.size() < 40);
+        assert(frame.size() * 20 < fullFrame);
+
+        board.removeObserver(&display);
+        std::cout << "Changed squares test: PASS\n";
+    }
+
+    /**
+     * @test Testing that switching to a smaller board clears the screen again
+     */
+    void AnsiDisplayTest::testBoardResize() {
+        GameBoard large = seededBoard(33);
+        GameBoard small = seededBoard(33, 6);
+        std::ostringstream terminal;
+        AnsiDisplay display(terminal);
+        display.update(&large);
+        display.display();
+
+        terminal.str("");
+        display.update(&small);
+        display.display();
+        std::string frame = terminal.str();
+        assert(frame.compare(0, 4, "\x1b[2J") == 0);
+        assert(frame.find(cursorTo(8, 0)) != std::string::npos);
+        assert(frame.find(cursorTo(9, 0)) == std::string::npos);
+        std::cout << "Board resize test: PASS\n";
+    }
+
+    bool AnsiDisplayTest::doTests() {
+        bool allTestsPassed = true;
+        try {
+            std::cout << "-------------------------\n";
+            std::cout << "AnsiDisplay unit tests\n";
+            std::cout << "-------------------------\n";
+
+            testFirstFrame();
+            testChangedSquaresOnly();
+            testBoardResize();
+
+        } catch (const std::exception& e) {
+            std::cout << "Test failed with exception: " << e.what() << std::endl;
+            allTestsPassed = false;
+        }
+
+        return allTestsPassed;
+    }
+}
+
+// Main function
+int main() {
+    Paintbots::AnsiDisplayTest tester;
+    return tester.doTests() ? 0 : 1;
+}
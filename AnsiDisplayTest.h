@@ -0,0 +1,32 @@
+#ifndef ANSI_DISPLAY_TEST_H
+#define ANSI_DISPLAY_TEST_H
+
+#include "ITest.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+    class AnsiDisplayTest : public ITest {
+        private:
+            /**
+             * Tests that the first frame clears the screen and draws every square once
+             */
+            void testFirstFrame();
+
+            /**
+             * Tests that a turn redraws only the squares that changed
+             */
+            void testChangedSquaresOnly();
+
+            /**
+             * Tests that a board of another size is drawn from scratch
+             */
+            void testBoardResize();
+
+        public:
+            bool doTests() override;
+    };
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "AntiRandom.h"
+#include "Directions.h"
 #include <cstdlib>
 #include <cstring>  
 #include <stdexcept>  
@@ -14,7 +15,11 @@ AntiRandom::AntiRandom() :
     rng(std::time(nullptr)),
     paintBlobsLeft(30),
     moveCount(0),
-    currentDirection(NORTH) {}
+    currentDirection(NORTH),
+    myTerritory(0),
+    enemyTerritory(0),
+    territoryKnown(false),
+    territoryAge(0) {}
 
 /**
  * Returns name of the robot 
@@ -65,23 +70,24 @@ bool AntiRandom::isSafeMove(ExternalBoardSquare** srs, RobotMoveRequest::RobotMo
 }
 
 /**
- * Analyzes the current state of the board
+ * Counts territory from the paint layers on the first move and every 
+ * TERRITORY_REFRESH moves after, keeping the last count in between and once the 
+ * long range scans run out 
  */
-void AntiRandom::analyzeBoardState(ExternalBoardSquare** lrs, int& myTerritory, int& enemyTerritory) {
-    myTerritory = 0;
-    enemyTerritory = 0;
-    
-    for(int i = 1; i <= GameBoard::BOARD_SIZE; i++) {
-        for(int j = 1; j <= GameBoard::BOARD_SIZE; j++) {
-            if((robotColor == RobotMoveRequest::RED && lrs[i][j].getSquareColor() == RED) ||
-               (robotColor == RobotMoveRequest::BLUE && lrs[i][j].getSquareColor() == BLUE)) {
-                myTerritory++;
-            } else if((robotColor == RobotMoveRequest::RED && lrs[i][j].getSquareColor() == BLUE) ||
-                      (robotColor == RobotMoveRequest::BLUE && lrs[i][j].getSquareColor() == RED)) {
-                enemyTerritory++;
-            }
-        }
+void AntiRandom::analyzeBoardState(AgentContext& context) {
+    if (territoryKnown && ++territoryAge < TERRITORY_REFRESH) {
+        return;
     }
+    const BitBoard* layers = context.requestLayers();
+    if (!layers) {
+        return;
+    }
+    int red = layers->count(BitBoard::RED_LAYER);
+    int blue = layers->count(BitBoard::BLUE_LAYER);
+    myTerritory = (robotColor == RobotMoveRequest::RED) ? red : blue;
+    enemyTerritory = (robotColor == RobotMoveRequest::RED) ? blue : red;
+    territoryKnown = true;
+    territoryAge = 0;
 }
 
 /**
@@ -128,25 +134,47 @@ void AntiRandom::setRobotColor(RobotMoveRequest::RobotColor c) {
     robotColor = c;
 }
 
+/**
+ * Reseeds the random number generator, both halves of the seed count 
+ */
+void AntiRandom::setSeed(uint64_t seed) {
+    std::seed_seq sequence{uint32_t(seed), uint32_t(seed >> 32)};
+    rng.seed(sequence);
+}
+
+/**
+ * A new match starts without a territory count 
+ */
+void AntiRandom::setBoardSize(int size) {
+    (void)size;
+    territoryKnown = false;
+    territoryAge = 0;
+}
+
+/**
+ * Gets the move, counting territory from the bitboard layers 
+ */
+RobotMoveRequest AntiRandom::nextMove(AgentContext& context) {
+    analyzeBoardState(context);
+    return decideMove(context.shortRangeScan());
+}
 
 /**
  * Gets the move after deciding on different moves 
  */
-RobotMoveRequest* AntiRandom::getMove(ExternalBoardSquare** srs, ExternalBoardSquare** lrs) {
+RobotMoveRequest AntiRandom::decideMove(ExternalBoardSquare** srs) {
     moveCount++;
-    RobotMoveRequest* request = new RobotMoveRequest();
-    request->robot = robotColor;
-    request->shoot = false;
+    RobotMoveRequest request = {};
+    request.robot = robotColor;
+    request.shoot = false;
     
     // Initialize shot decision
     Direction enemyDir;
     int enemyDist;
     bool enemyVisible = isEnemyInRange(srs, enemyDir, enemyDist);
     
-    // Get board state information
-    int myTerritory, enemyTerritory;
-    analyzeBoardState(lrs, myTerritory, enemyTerritory);
-    bool losing = enemyTerritory >= myTerritory;
+    // Compare territory, a robot that never counted has no reason to think it is losing
+    bool losing = territoryKnown && enemyTerritory >= myTerritory;
     
     // Determine best move direction
     Direction targetDir = findBestDirection(srs);
@@ -159,72 +187,34 @@ RobotMoveRequest* AntiRandom::getMove(ExternalBoardSquare** srs, ExternalBoardSq
     // Rotate to face target direction if needed
     if(currentDirection != targetDir) {
         // Choose shortest rotation
-        int clockwise = 0, counterClockwise = 0;
-        Direction tempDir = currentDirection;
-        
-        // Count clockwise rotations needed
-        while(tempDir != targetDir) {
-            clockwise++;
-            switch(tempDir) {
-                case NORTH: tempDir = EAST; break;
-                case EAST: tempDir = SOUTH; break;
-                case SOUTH: tempDir = WEST; break;
-                case WEST: tempDir = NORTH; break;
-            }
-        }
-        
-        // Count counterclockwise rotations needed
-        tempDir = currentDirection;
-        while(tempDir != targetDir) {
-            counterClockwise++;
-            switch(tempDir) {
-                case NORTH: tempDir = WEST; break;
-                case WEST: tempDir = SOUTH; break;
-                case SOUTH: tempDir = EAST; break;
-                case EAST: tempDir = NORTH; break;
-            }
-        }
+        int clockwise = turnsRight(currentDirection, targetDir);
+        int counterClockwise = 4 - clockwise;
         
         // Choose shorter rotation
         if(clockwise <= counterClockwise) {
-            request->move = RobotMoveRequest::ROTATERIGHT;
-            switch(currentDirection) {
-                case NORTH: currentDirection = EAST; break;
-                case EAST: currentDirection = SOUTH; break;
-                case SOUTH: currentDirection = WEST; break;
-                case WEST: currentDirection = NORTH; break;
-            }
+            request.move = RobotMoveRequest::ROTATERIGHT;
+            currentDirection = rotateRight(currentDirection);
         } else {
-            request->move = RobotMoveRequest::ROTATELEFT;
-            switch(currentDirection) {
-                case NORTH: currentDirection = WEST; break;
-                case WEST: currentDirection = SOUTH; break;
-                case SOUTH: currentDirection = EAST; break;
-                case EAST: currentDirection = NORTH; break;
-            }
+            request.move = RobotMoveRequest::ROTATELEFT;
+            currentDirection = rotateLeft(currentDirection);
         }
     }
     // Move forward if facing target direction and safe
     else if(isSafeMove(srs, RobotMoveRequest::FORWARD)) {
-        request->move = RobotMoveRequest::FORWARD;
+        request.move = RobotMoveRequest::FORWARD;
     }
 
 
     // Rotate if can't move forward
     else {
-        request->move = RobotMoveRequest::ROTATERIGHT;
-        switch(currentDirection) {
-            case NORTH: currentDirection = EAST; break;
-            case EAST: currentDirection = SOUTH; break;
-            case SOUTH: currentDirection = WEST; break;
-            case WEST: currentDirection = NORTH; break;
-        }
+        request.move = RobotMoveRequest::ROTATERIGHT;
+        currentDirection = rotateRight(currentDirection);
     }
     
     // Decide whether to shoot
     if(enemyVisible) {
-        request->shoot = shouldShoot(enemyDir);
-        if(request->shoot) paintBlobsLeft--;
+        request.shoot = shouldShoot(enemyDir);
+        if(request.shoot) paintBlobsLeft--;
     }
     
     return request;
@@ -17,6 +17,11 @@ namespace Paintbots {
             int paintBlobsLeft; // number of paintblobs left to shoot 
             int moveCount; // counting the number of moves 
             Direction currentDirection; // keeps track of the robot's current direction 
+            static const int TERRITORY_REFRESH = 50; // moves between two territory counts, so the scans last through the match 
+            int myTerritory; // squares in the robot's color at the last count 
+            int enemyTerritory; // squares in the enemy's color at the last count 
+            bool territoryKnown; // whether the territory was counted at all in this match 
+            int territoryAge; // moves since the territory was last counted 
             std::queue<RobotMoveRequest::RobotMove> plannedMoves; // queue to keep track of the moves the robot is going to make 
             
             /**
@@ -30,9 +35,14 @@ namespace Paintbots {
             bool isSafeMove(ExternalBoardSquare** srs, RobotMoveRequest::RobotMove move);
 
             /**
-             * Analyzes board state to predict the best move 
+             * Counts territory with a popcount over the paint layers when the count is due 
              */
-            void analyzeBoardState(ExternalBoardSquare** lrs, int& myTerritory, int& enemyTerritory);
+            void analyzeBoardState(AgentContext& context);
+
+            /**
+             * Picks the move from the short range scan and the last territory count 
+             */
+            RobotMoveRequest decideMove(ExternalBoardSquare** srs);
 
             /**
              * Finds the best direction to move in based on the scan 
@@ -62,14 +72,26 @@ namespace Paintbots {
             std::string getRobotCreator() override;
 
             /**
-             * Gets the move based on different factors 
+             * Gets the move based on different factors, reading the territory from the 
+             * bitboard layers every TERRITORY_REFRESH moves, so the long range scan is 
+             * never built 
              */
-            RobotMoveRequest* getMove(ExternalBoardSquare** srs, ExternalBoardSquare** lrs) override;
+            RobotMoveRequest nextMove(AgentContext& context) override;
 
             /**
              * Sets robot color 
              */
             void setRobotColor(RobotMoveRequest::RobotColor c) override;
+
+            /**
+             * Reseeds the random number generator from the match seed 
+             */
+            void setSeed(uint64_t seed) override;
+
+            /**
+             * Forgets the territory of the previous match 
+             */
+            void setBoardSize(int size) override;
     };
 }
 
@@ -0,0 +1,251 @@
+#include "AsyncObserver.h"
+#include "LayoutCorpus.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * Allocates every slot before the thread starts
+     */
+    AsyncObserver::AsyncObserver(Observer* target, Backpressure policy, size_t capacity) :
+        target(target),
+        policy(policy),
+        mask(0),
+        tail(0),
+        backlogged(false),
+        lost(false),
+        droppedCount(0),
+        coalescedCount(0),
+        head(0),
+        consumerSleeping(false),
+        producerWaiting(false),
+        stopping(false) {
+        if (target == nullptr) {
+            throw std::invalid_argument("Cannot forward to a null observer");
+        }
+        if (capacity == 0) {
+            throw std::invalid_argument("An observer queue needs at least one slot");
+        }
+        size_t slotCount = 1;
+        while (slotCount < capacity) {
+            slotCount <<= 1;
+        }
+        slots.resize(slotCount);
+        mask = slotCount - 1;
+        thread = std::thread(&AsyncObserver::run, this);
+    }
+
+    /**
+     * The thread empties the ring before it stops, so the backlog only has to make it
+     * into the ring
+     */
+    AsyncObserver::~AsyncObserver() {
+        queueBacklog();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        thread.join();
+    }
+
+    void AsyncObserver::update(Observable* subject) {
+        publish(subject, nullptr);
+    }
+
+    void AsyncObserver::update(Observable* subject, const BoardChange& change) {
+        publish(subject, &change);
+    }
+
+    /**
+     * Folds in what an earlier full ring held back, then queues the notification or
+     * applies the policy. Changes of boards of different sizes do not merge, so those
+     * turn into a whole board update. The backlog keeps the squares of its last
+     * notification, so the board is never read again after a notification returns
+     */
+    void AsyncObserver::publish(Observable* subject, const BoardChange* change) {
+        const GameBoard* board = static_cast<GameBoard*>(subject);
+        if (!board) return;
+
+        bool full = change == nullptr || lost;
+        const BoardChange* queued = change;
+        if (backlogged) {
+            if (!full && !backlog.full && backlog.change.getStride() == change->getStride()) {
+                backlog.change.merge(*change);
+            } else {
+                full = true;
+            }
+            queued = &backlog.change;
+        }
+
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load() > mask) {
+            switch (policy) {
+                case DROP:
+                    ++droppedCount;
+                    lost = true;
+                    return;
+                case COALESCE:
+                    if (!backlogged && !full) {
+                        backlog.change = *change;
+                    }
+                    capture(*board, backlog, full);
+                    backlogged = true;
+                    ++coalescedCount;
+                    return;
+                case BLOCK:
+                    waitForSpace();
+                    break;
+            }
+        }
+
+        Slot& slot = slots[position & mask];
+        capture(*board, slot, full);
+        if (!full) {
+            slot.change = *queued;
+        }
+        backlogged = false;
+        lost = false;
+        tail.store(position + 1);
+        wakeConsumer();
+    }
+
+    /**
+     * Only the playable squares, the walls around them are the same on every board of
+     * a size
+     */
+    void AsyncObserver::capture(const GameBoard& board, Slot& slot, bool full) {
+        int size = board.getSize();
+        slot.size = size;
+        slot.squares.resize(size_t(size) * size);
+        uint8_t* packed = slot.squares.data();
+        for (int row = 1; row <= size; ++row) {
+            for (int col = 1; col <= size; ++col) {
+                *packed++ = board.getSquare(row, col).packedState();
+            }
+        }
+        slot.full = full;
+    }
+
+    /**
+     * Swaps the backlog into the free slot, so both keep their storage
+     */
+    void AsyncObserver::queueBacklog() {
+        if (!backlogged) {
+            return;
+        }
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load() > mask) {
+            waitForSpace();
+        }
+        std::swap(slots[position & mask], backlog);
+        backlogged = false;
+        tail.store(position + 1);
+        wakeConsumer();
+    }
+
+    /**
+     * Announces the wait before checking again, so the thread either sees the flag
+     * after freeing a slot or the check sees the freed slot
+     */
+    void AsyncObserver::waitForSpace() {
+        std::unique_lock<std::mutex> lock(mutex);
+        producerWaiting = true;
+        changed.wait(lock, [this] {return tail.load() - head.load() <= mask;});
+        producerWaiting = false;
+    }
+
+    /**
+     * Only takes the lock when the thread went to sleep, the flag is read after the
+     * new tail is published
+     */
+    void AsyncObserver::wakeConsumer() {
+        if (consumerSleeping.load()) {
+            std::lock_guard<std::mutex> lock(mutex);
+            changed.notify_all();
+        }
+    }
+
+    /**
+     * Queues the coalesced backlog, then waits for the thread to catch up with the tail
+     */
+    void AsyncObserver::drain() {
+        queueBacklog();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        producerWaiting = true;
+        changed.wait(lock, [this] {return head.load() == tail.load();});
+        producerWaiting = false;
+        if (failure) {
+            std::exception_ptr thrown = failure;
+            failure = nullptr;
+            std::rethrow_exception(thrown);
+        }
+    }
+
+    /**
+     * Builds the mirror from the squares like a board from a stored layout, later
+     * slots of the same size are written over it square by square
+     */
+    void AsyncObserver::loadMirror(const Slot& slot) {
+        if (!mirror || mirror->getSize() != slot.size) {
+            Config config;
+            config.setBoardSize(slot.size);
+            BoardLayout layout = {0, slot.size, slot.squares.data()};
+            if (mirror) {
+                *mirror = GameBoard(config, layout);
+            } else {
+                mirror.reset(new GameBoard(config, layout));
+            }
+            return;
+        }
+        const uint8_t* packed = slot.squares.data();
+        for (int row = 1; row <= slot.size; ++row) {
+            for (int col = 1; col <= slot.size; ++col) {
+                mirror->getSquare(row, col).setPackedState(*packed++);
+            }
+        }
+    }
+
+    /**
+     * A slot stays with the thread until the target returns, the producer only reuses
+     * it after head moves past it
+     */
+    void AsyncObserver::run() {
+        while (true) {
+            uint64_t position = head.load(std::memory_order_relaxed);
+            if (position == tail.load()) {
+                std::unique_lock<std::mutex> lock(mutex);
+                consumerSleeping = true;
+                changed.wait(lock, [&] {return position != tail.load() || stopping;});
+                consumerSleeping = false;
+                if (position == tail.load()) {
+                    return;
+                }
+                continue;
+            }
+
+            Slot& slot = slots[position & mask];
+            try {
+                loadMirror(slot);
+                if (slot.full) {
+                    target->update(mirror.get());
+                } else {
+                    target->update(mirror.get(), slot.change);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+            head.store(position + 1);
+            if (producerWaiting.load()) {
+                std::lock_guard<std::mutex> lock(mutex);
+                changed.notify_all();
+            }
+        }
+    }
+}
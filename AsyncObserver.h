@@ -0,0 +1,172 @@
+#ifndef ASYNC_OBSERVER_H
+#define ASYNC_OBSERVER_H
+
+#include "ObserverPattern.h"
+#include "GameBoard.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class AsyncObserver
+     * Hands a board's notifications to another observer on a thread of its own
+     *
+     * Attach it to a GameBoard in place of a slow observer (logging, metrics, a display
+     * that writes to a slow terminal). Every notification copies the packed squares of
+     * the board and the change into the next slot of a bounded single producer, single
+     * consumer ring and returns; the thread drains the ring and calls the wrapped
+     * observer with a board of its own holding those squares, so the wrapped observer
+     * never races the game. Scores follow from the squares, paint blobs and hit counters
+     * are not copied. The slots are allocated up front and reused, so publishing
+     * allocates nothing once the ring has been filled.
+     *
+     * A full ring is handled by the Backpressure policy. Notifications have to come
+     * from one thread, the one playing the game.
+     */
+    class AsyncObserver : public Observer {
+        public:
+            /**
+             * @enum What a notification does when the ring is full
+             */
+            enum Backpressure {
+                DROP,     // skip it, the next delivered notification redraws everything
+                COALESCE, // merge it into the next notification that fits
+                BLOCK     // wait for the observer to make room
+            };
+
+            /**
+             * Starts the thread
+             * @param target Observer called on the thread, has to outlive this one
+             * @param capacity Notifications the ring holds, rounded up to a power of two
+             * @throws std::invalid_argument if target is null or capacity is 0
+             */
+            AsyncObserver(Observer* target, Backpressure policy, size_t capacity = 16);
+
+            /**
+             * Delivers what is still queued, coalesced notifications included, and stops
+             * the thread. Remove it from the board first
+             */
+            ~AsyncObserver();
+
+            /**
+             * Queues a copy of the squares
+             */
+            void update(Observable* subject) override;
+
+            /**
+             * Queues a copy of the squares and the change
+             */
+            void update(Observable* subject, const BoardChange& change) override;
+
+            /**
+             * Waits until the target has handled every notification so far, coalesced
+             * ones included
+             * @throws whatever the target threw since the last drain
+             */
+            void drain();
+
+            /**
+             * @return notifications handed to the target
+             */
+            uint64_t delivered() const {return head.load();}
+
+            /**
+             * @return notifications skipped under DROP
+             */
+            uint64_t dropped() const {return droppedCount;}
+
+            /**
+             * @return notifications merged into a later one under COALESCE
+             */
+            uint64_t coalesced() const {return coalescedCount;}
+
+        private:
+            /**
+             * @struct One queued notification
+             */
+            struct Slot {
+                Slot() : size(0), full(false) {}
+
+                int size; // playable rows and columns of the board
+                std::vector<uint8_t> squares; // packed state of the playable squares as notified, row major
+                BoardChange change; // what changed, unused if full
+                bool full; // whether the target should reload the whole board
+            };
+
+            Observer* target;
+            Backpressure policy;
+            std::vector<Slot> slots; // the ring, a power of two long
+            size_t mask; // slots.size() - 1
+
+            // Written by the producer only, except for the atomics
+            std::atomic<uint64_t> tail; // notifications queued so far
+            Slot backlog; // coalesced notifications not queued yet, squares of the last one
+            bool backlogged; // whether backlog holds anything
+            bool lost; // whether a notification was dropped since the last queued one
+            uint64_t droppedCount;
+            uint64_t coalescedCount;
+
+            // Written by the consumer only, except for the atomics
+            std::atomic<uint64_t> head; // notifications handled so far
+            std::unique_ptr<GameBoard> mirror; // board the target sees, built on the first delivery and kept at one address
+            std::exception_ptr failure; // first exception the target threw
+
+            std::atomic<bool> consumerSleeping; // set while the thread waits for work
+            std::atomic<bool> producerWaiting; // set while publish or drain wait for the thread
+            std::atomic<bool> stopping;
+            std::mutex mutex; // guards the sleeping handshakes and failure
+            std::condition_variable changed;
+            std::thread thread;
+
+            /**
+             * Queues a notification, change is null for a whole board update
+             */
+            void publish(Observable* subject, const BoardChange* change);
+
+            /**
+             * Copies the squares of a board into a slot
+             */
+            static void capture(const GameBoard& board, Slot& slot, bool full);
+
+            /**
+             * Queues the coalesced notifications, waiting for room if needed
+             */
+            void queueBacklog();
+
+            /**
+             * Waits until the ring has a free slot
+             */
+            void waitForSpace();
+
+            /**
+             * Wakes the thread if it is waiting for work
+             */
+            void wakeConsumer();
+
+            /**
+             * Writes the squares of a slot onto the mirror, rebuilding it for a board of
+             * another size
+             */
+            void loadMirror(const Slot& slot);
+
+            /**
+             * Hands queued notifications to the target until stopped
+             */
+            void run();
+
+            AsyncObserver(const AsyncObserver&) = delete;
+            AsyncObserver& operator = (const AsyncObserver&) = delete;
+    };
+}
+
+#endif
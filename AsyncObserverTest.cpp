@@ -0,0 +1,315 @@
+#include "AsyncObserverTest.h"
+#include "AsyncObserver.h"
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    namespace {
+
+        const int PAINTED = 10; // squares of the first row painted by every test
+
+        /**
+         * @class Observer that can be held up and records what it was told
+         */
+        class GatedObserver : public Observer {
+            public:
+                GatedObserver() : fullUpdates(0), changes(0), seenBoard(nullptr), open(true) {}
+
+                /**
+                 * Holds up updates until released
+                 */
+                void close() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    open = false;
+                }
+
+                void release() {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        open = true;
+                    }
+                    opened.notify_all();
+                }
+
+                void update(Observable* subject) override {
+                    waitUntilOpen();
+                    ++fullUpdates;
+                    record(subject);
+                }
+
+                void update(Observable* subject, const BoardChange& change) override {
+                    waitUntilOpen();
+                    ++changes;
+                    if (squares.getStride() != change.getStride()) {
+                        squares.reset(change.getStride());
+                    }
+                    squares.merge(change);
+                    record(subject);
+                }
+
+                int fullUpdates; // updates without a change
+                int changes; // updates with a change
+                BoardChange squares; // every square reported changed
+                std::vector<SquareColor> firstSquare; // color of square 1,1 at every update
+                std::vector<SquareColor> row; // colors of the painted squares at the last update
+                const GameBoard* seenBoard; // board the last update came with
+
+            private:
+                std::mutex mutex;
+                std::condition_variable opened;
+                bool open;
+
+                void waitUntilOpen() {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    opened.wait(lock, [this] {return open;});
+                }
+
+                void record(Observable* subject) {
+                    const GameBoard* board = static_cast<GameBoard*>(subject);
+                    assert(seenBoard == nullptr || seenBoard == board);
+                    seenBoard = board;
+                    firstSquare.push_back(board->getSquare(1, 1).getSquareColor());
+                    row.clear();
+                    for (int col = 1; col <= PAINTED; ++col) {
+                        row.push_back(board->getSquare(1, col).getSquareColor());
+                    }
+                }
+        };
+
+        /**
+         * @class Observer that always fails
+         */
+        class ThrowingObserver : public Observer {
+            public:
+                void update(Observable* subject) override {
+                    (void)subject;
+                    throw std::runtime_error("observer failed");
+                }
+        };
+
+        /**
+         * Builds a seeded board
+         */
+        GameBoard seededBoard(uint64_t seed) {
+            Config config;
+            config.setSeed(seed);
+            return GameBoard(config);
+        }
+
+        /**
+         * Paints the first squares of row 1 one notification at a time
+         */
+        void paintRow(GameBoard& board, SquareColor color) {
+            for (int col = 1; col <= PAINTED; ++col) {
+                board.setSquareColor(1, col, color);
+            }
+        }
+
+        /**
+         * Asserts that the target saw the painted squares as they are on the board
+         */
+        void assertRowMatches(const GatedObserver& observer, const GameBoard& board) {
+            assert(int(observer.row.size()) == PAINTED);
+            for (int col = 1; col <= PAINTED; ++col) {
+                assert(observer.row[col - 1] == board.getSquare(1, col).getSquareColor());
+            }
+        }
+    }
+
+    /**
+     * @test Testing that changes arrive in order, on a board owned by the observer
+     */
+    void AsyncObserverTest::testDeliversInOrder() {
+        GameBoard board = seededBoard(41);
+        GatedObserver target;
+        AsyncObserver async(&target, AsyncObserver::BLOCK, 4);
+        board.addObserver(&async);
+
+        std::vector<SquareColor> painted;
+        for (int i = 0; i < 40; ++i) {
+            SquareColor color = i % 3 == 0 ? RED : (i % 3 == 1 ? BLUE : WHITE);
+            board.setSquareColor(1, 1, color);
+            painted.push_back(color);
+        }
+        async.drain();
+        board.removeObserver(&async);
+
+        assert(async.delivered() == 40);
+        assert(target.changes == 40);
+        assert(target.fullUpdates == 0);
+        assert(target.firstSquare == painted);
+        assert(target.seenBoard != &board);
+        std::cout << "Delivers in order test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a full queue drops changes and then reloads the whole board
+     */
+    void AsyncObserverTest::testDropPolicy() {
+        GameBoard board = seededBoard(42);
+        GatedObserver target;
+        AsyncObserver async(&target, AsyncObserver::DROP, 2);
+        board.addObserver(&async);
+
+        target.close();
+        paintRow(board, RED);
+        assert(async.dropped() == PAINTED - 2);
+        target.release();
+        async.drain();
+        assert(target.changes == 2);
+        assert(target.fullUpdates == 0);
+
+        // The next notification makes up for the dropped ones
+        board.setSquareColor(2, 1, BLUE);
+        async.drain();
+        board.removeObserver(&async);
+        assert(target.fullUpdates == 1);
+        assertRowMatches(target, board);
+        std::cout << "Drop policy test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a full queue merges changes into one later notification
+     */
+    void AsyncObserverTest::testCoalescePolicy() {
+        GameBoard board = seededBoard(43);
+        GatedObserver target;
+        AsyncObserver async(&target, AsyncObserver::COALESCE, 2);
+        board.addObserver(&async);
+
+        target.close();
+        paintRow(board, BLUE);
+        assert(async.coalesced() == PAINTED - 2);
+        target.release();
+        async.drain();
+        board.removeObserver(&async);
+
+        assert(target.changes == 3);
+        assert(target.fullUpdates == 0);
+        for (int col = 1; col <= PAINTED; ++col) {
+            assert(target.squares.isDirty(1, col));
+        }
+        assertRowMatches(target, board);
+        std::cout << "Coalesce policy test: PASS\n";
+    }
+
+    /**
+     * @test Testing that coalesced changes still queued when the observer is destroyed
+     * reach the target
+     */
+    void AsyncObserverTest::testDestructorFlushesBacklog() {
+        GameBoard board = seededBoard(46);
+        GatedObserver target;
+        {
+            AsyncObserver async(&target, AsyncObserver::COALESCE, 2);
+            board.addObserver(&async);
+            target.close();
+            paintRow(board, RED);
+            board.removeObserver(&async);
+            assert(async.coalesced() == PAINTED - 2);
+            target.release();
+        }
+
+        assert(target.changes == 3);
+        for (int col = 1; col <= PAINTED; ++col) {
+            assert(target.squares.isDirty(1, col));
+        }
+        assertRowMatches(target, board);
+        std::cout << "Destructor flushes backlog test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a full queue holds up the game until the observer catches up
+     */
+    void AsyncObserverTest::testBlockPolicy() {
+        GameBoard board = seededBoard(44);
+        GatedObserver target;
+        AsyncObserver async(&target, AsyncObserver::BLOCK, 2);
+        board.addObserver(&async);
+
+        target.close();
+        std::thread releaser([&target] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            target.release();
+        });
+        paintRow(board, RED);
+        releaser.join();
+        async.drain();
+        board.removeObserver(&async);
+
+        assert(target.changes == PAINTED);
+        assert(async.dropped() == 0);
+        assert(async.coalesced() == 0);
+        assertRowMatches(target, board);
+        std::cout << "Block policy test: PASS\n";
+    }
+
+    /**
+     * @test Testing that drain reports the target's exception once
+     */
+    void AsyncObserverTest::testTargetFailure() {
+        GameBoard board = seededBoard(45);
+        ThrowingObserver target;
+        AsyncObserver async(&target, AsyncObserver::BLOCK);
+        board.addObserver(&async);
+        board.setSquareColor(1, 1, RED);
+        board.setSquareColor(1, 2, RED);
+
+        bool threw = false;
+        try {
+            async.drain();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        async.drain();
+        assert(async.delivered() == 2);
+        board.removeObserver(&async);
+
+        threw = false;
+        try {
+            AsyncObserver invalid(nullptr, AsyncObserver::DROP);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+        std::cout << "Target failure test: PASS\n";
+    }
+
+    bool AsyncObserverTest::doTests() {
+        bool allTestsPassed = true;
+        try {
+            std::cout << "-------------------------\n";
+            std::cout << "AsyncObserver unit tests\n";
+            std::cout << "-------------------------\n";
+
+            testDeliversInOrder();
+            testDropPolicy();
+            testCoalescePolicy();
+            testDestructorFlushesBacklog();
+            testBlockPolicy();
+            testTargetFailure();
+
+        } catch (const std::exception& e) {
+            std::cout << "Test failed with exception: " << e.what() << std::endl;
+            allTestsPassed = false;
+        }
+
+        return allTestsPassed;
+    }
+}
+
+// Main function
+int main() {
+    Paintbots::AsyncObserverTest tester;
+    return tester.doTests() ? 0 : 1;
+}
@@ -0,0 +1,47 @@
+#ifndef ASYNC_OBSERVER_TEST_H
+#define ASYNC_OBSERVER_TEST_H
+
+#include "ITest.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+    class AsyncObserverTest : public ITest {
+        private:
+            /**
+             * Tests that every change reaches the target in order, with a consistent board
+             */
+            void testDeliversInOrder();
+
+            /**
+             * Tests that dropped changes are made up for by a whole board update
+             */
+            void testDropPolicy();
+
+            /**
+             * Tests that changes held back by a full queue are merged, not lost
+             */
+            void testCoalescePolicy();
+
+            /**
+             * Tests that destroying the observer delivers the changes it coalesced
+             */
+            void testDestructorFlushesBacklog();
+
+            /**
+             * Tests that a full queue makes the game wait instead of losing changes
+             */
+            void testBlockPolicy();
+
+            /**
+             * Tests that an exception thrown by the target is reported by drain
+             */
+            void testTargetFailure();
+
+        public:
+            bool doTests() override;
+    };
+}
+
+#endif
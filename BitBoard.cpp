@@ -0,0 +1,183 @@
+#include "BitBoard.h"
+#include "Directions.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    namespace {
+
+        /**
+         * @struct Precomputed rays of a default sized board, for every square and
+         * direction the squares a shot passes on its way to the wall, not counting the
+         * square it starts from
+         */
+        struct RayTable {
+            static const int SIZE = BitBoard::DEFAULT_SIZE;
+            uint64_t masks[4][SIZE * SIZE][BitBoard::DEFAULT_WORDS];
+
+            RayTable() {
+                std::memset(masks, 0, sizeof(masks));
+                for (int dir = 0; dir < 4; ++dir) {
+                    for (int row = 1; row <= SIZE; ++row) {
+                        for (int col = 1; col <= SIZE; ++col) {
+                            uint64_t* ray = masks[dir][(row - 1) * SIZE + (col - 1)];
+                            int r = row + ROW_STEP[dir];
+                            int c = col + COL_STEP[dir];
+                            while (r >= 1 && r <= SIZE && c >= 1 && c <= SIZE) {
+                                int bit = (r - 1) * SIZE + (c - 1);
+                                ray[bit / 64] |= uint64_t(1) << (bit % 64);
+                                r += ROW_STEP[dir];
+                                c += COL_STEP[dir];
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        /**
+         * Gets the ray table, built on first use
+         */
+        const RayTable& rays() {
+            static const RayTable table;
+            return table;
+        }
+    }
+
+    /**
+     * Creates an empty board
+     */
+    BitBoard::BitBoard(int size) :
+        size(size),
+        wordsPerLayer((size * size + 63) / 64),
+        bits(LAYER_COUNT * wordsPerLayer, 0) {
+        if (size <= 0) {
+            throw std::invalid_argument("Bitboard size must be positive");
+        }
+    }
+
+    /**
+     * Empties every layer
+     */
+    void BitBoard::clear() {
+        std::fill(bits.begin(), bits.end(), 0);
+    }
+
+    /**
+     * Sets or clears a square, squares outside the walls are ignored
+     */
+    void BitBoard::set(Layer layer, int row, int col, bool value) {
+        if (!isPlayable(row, col)) {
+            return;
+        }
+        int bit = bitIndex(row, col);
+        uint64_t mask = uint64_t(1) << (bit % 64);
+        uint64_t& word = bits[layer * wordsPerLayer + bit / 64];
+        if (value) {
+            word |= mask;
+        } else {
+            word &= ~mask;
+        }
+    }
+
+    /**
+     * Tests a square, squares outside the walls are never set
+     */
+    bool BitBoard::test(Layer layer, int row, int col) const {
+        if (!isPlayable(row, col)) {
+            return false;
+        }
+        int bit = bitIndex(row, col);
+        return (bits[layer * wordsPerLayer + bit / 64] >> (bit % 64)) & 1;
+    }
+
+    /**
+     * Counts a layer one word at a time
+     */
+    int BitBoard::count(Layer layer) const {
+        const uint64_t* layerWords = words(layer);
+        int total = 0;
+        for (int i = 0; i < wordsPerLayer; ++i) {
+            total += popcount(layerWords[i]);
+        }
+        return total;
+    }
+
+    /**
+     * Counts set bits, using the hardware instruction where the compiler offers it
+     */
+    int BitBoard::popcount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    /**
+     * Validates the squares, then checks the ray with the masks on default sized
+     * boards and by stepping along it otherwise
+     */
+    bool BitBoard::inLineOfFire(int fromRow, int fromCol, Direction facing, int toRow, int toCol) const {
+        if (!isPlayable(fromRow, fromCol) || !isPlayable(toRow, toCol)) {
+            return false;
+        }
+        if (static_cast<int>(facing) < 0 || static_cast<int>(facing) > 3) {
+            throw std::invalid_argument("Invalid robot direction");
+        }
+
+        if (size == DEFAULT_SIZE) {
+            return rayMasksClear(bitIndex(fromRow, fromCol), facing, bitIndex(toRow, toCol));
+        }
+        return rayWalkClear(fromRow, fromCol, facing, toRow, toCol);
+    }
+
+    /**
+     * The squares between shooter and target are the shooter's ray minus the target's
+     * ray in the same direction and minus the target itself
+     */
+    bool BitBoard::rayMasksClear(int from, Direction facing, int target) const {
+        const uint64_t* shooterRay = rays().masks[facing][from];
+        const uint64_t* targetRay = rays().masks[facing][target];
+        if (!((shooterRay[target / 64] >> (target % 64)) & 1)) {
+            return false;
+        }
+
+        const uint64_t* rocks = words(ROCK_LAYER);
+        const uint64_t* walls = words(WALL_LAYER);
+        for (int i = 0; i < DEFAULT_WORDS; ++i) {
+            uint64_t between = shooterRay[i] & ~targetRay[i];
+            if (i == target / 64) {
+                between &= ~(uint64_t(1) << (target % 64));
+            }
+            if (between & (rocks[i] | walls[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Steps from the shooter towards the wall until the target or an obstacle
+     */
+    bool BitBoard::rayWalkClear(int fromRow, int fromCol, Direction facing, int toRow, int toCol) const {
+        int row = fromRow + ROW_STEP[facing];
+        int col = fromCol + COL_STEP[facing];
+        while (isPlayable(row, col)) {
+            if (row == toRow && col == toCol) {
+                return true;
+            }
+            if (test(ROCK_LAYER, row, col) || test(WALL_LAYER, row, col)) {
+                return false;
+            }
+            row += ROW_STEP[facing];
+            col += COL_STEP[facing];
+        }
+        return false;
+    }
+}
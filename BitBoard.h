@@ -0,0 +1,123 @@
+#ifndef BIT_BOARD_H
+#define BIT_BOARD_H
+
+#include "BoardSquare.h"
+#include <cstdint>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class BitBoard
+     * Layered bit representation of the playable squares of a board
+     *
+     * Every layer holds one bit per square inside the walls, packed row major into 64
+     * bit words, four of them for the default 15*15 = 225 squares. Scores become a
+     * popcount over a layer. On default sized boards line of fire checks become a few
+     * mask operations against precomputed rays; other sizes, for which a ray table
+     * would grow with the fourth power of the size, walk the ray over the layers
+     * instead. Coordinates use the GameBoard convention, rows and columns 1 to size
+     * with the walls at 0 and size + 1.
+     */
+    class BitBoard {
+        public:
+            static const int DEFAULT_SIZE = 15; // playable rows and columns of a default board
+            static const int DEFAULT_WORDS = 4; // 64 bit words per layer of a default board
+
+            /**
+             * @enum The layers kept for every board
+             */
+            enum Layer {
+                RED_LAYER,   // squares painted red
+                BLUE_LAYER,  // squares painted blue
+                ROCK_LAYER,  // rocks
+                FOG_LAYER,   // fog
+                WALL_LAYER,  // walls placed inside the border, the border itself is implicit
+                LAYER_COUNT
+            };
+
+            /**
+             * Creates a board of size * size squares with every layer empty
+             */
+            explicit BitBoard(int size = DEFAULT_SIZE);
+
+            /**
+             * @return playable rows and columns
+             */
+            int getSize() const {return size;}
+
+            /**
+             * @return 64 bit words per layer
+             */
+            int wordCount() const {return wordsPerLayer;}
+
+            /**
+             * Empties every layer
+             */
+            void clear();
+
+            /**
+             * Sets or clears the bit of a square in a layer
+             */
+            void set(Layer layer, int row, int col, bool value);
+
+            /**
+             * @return true if the square is set in the layer
+             */
+            bool test(Layer layer, int row, int col) const;
+
+            /**
+             * @return number of squares set in the layer
+             */
+            int count(Layer layer) const;
+
+            /**
+             * Gets the raw words of a layer, bit (row - 1) * size + (col - 1)
+             */
+            const uint64_t* words(Layer layer) const {return &bits[layer * wordsPerLayer];}
+
+            /**
+             * Checks whether a shot from a square hits a target square: the target has to
+             * lie on the ray leaving the shooter in the given direction, with no rock or
+             * wall on the squares in between
+             */
+            bool inLineOfFire(int fromRow, int fromCol, Direction facing, int toRow, int toCol) const;
+
+            /**
+             * @return number of set bits in a word
+             */
+            static int popcount(uint64_t word);
+
+        private:
+            int size; // playable rows and columns
+            int wordsPerLayer; // 64 bit words per layer
+            std::vector<uint64_t> bits; // the layers one after the other
+
+            /**
+             * @return true if the square is inside the walls
+             */
+            bool isPlayable(int row, int col) const {
+                return row >= 1 && row <= size && col >= 1 && col <= size;
+            }
+
+            /**
+             * @return bit index of a playable square
+             */
+            int bitIndex(int row, int col) const {return (row - 1) * size + (col - 1);}
+
+            /**
+             * Line of fire check against the precomputed rays of a default sized board
+             */
+            bool rayMasksClear(int from, Direction facing, int target) const;
+
+            /**
+             * Line of fire check stepping square by square, for any size
+             */
+            bool rayWalkClear(int fromRow, int fromCol, Direction facing, int toRow, int toCol) const;
+    };
+}
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef BOARD_CHANGE_H
+#define BOARD_CHANGE_H
+
+#include <cstdint>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class BoardChange
+     * What changed on a board since observers were last notified
+     *
+     * Holds the kinds of change as flags and the changed squares as a bitmask over
+     * the whole board, walls included, so changes merge with a bitwise or.
+     */
+    class BoardChange {
+        public:
+            /**
+             * @enum Kinds of change, several can be set at once
+             */
+            enum Kind {
+                SQUARES = 1 << 0, // squares were painted or edited
+                ROBOT_MOVED = 1 << 1, // a robot moved forward
+                ROBOT_TURNED = 1 << 2, // a robot rotated
+                PAINT_COLOR = 1 << 3, // a robot's paint color changed
+                HIT = 1 << 4, // a paint blob hit a robot
+                ROBOT_IDLE = 1 << 5 // a robot passed its turn
+            };
+
+            /**
+             * Starts empty for a board with stride rows and columns, walls included
+             */
+            explicit BoardChange(int stride = 0) {
+                reset(stride);
+            }
+
+            /**
+             * Empties the change and sizes it for a board
+             */
+            void reset(int stride) {
+                this->stride = stride;
+                dirty.assign((size_t(stride) * stride + 63) / 64, 0);
+                kinds = 0;
+            }
+
+            /**
+             * Empties the change, keeping its size
+             */
+            void clear() {
+                std::fill(dirty.begin(), dirty.end(), 0);
+                kinds = 0;
+            }
+
+            /**
+             * Records a change without squares
+             */
+            void add(Kind kind) {kinds |= kind;}
+
+            /**
+             * Records a changed square
+             */
+            void markSquare(int row, int col) {
+                int bit = row * stride + col;
+                dirty[bit / 64] |= uint64_t(1) << (bit % 64);
+                kinds |= SQUARES;
+            }
+
+            /**
+             * Adds another change of the same board into this one
+             */
+            void merge(const BoardChange& other) {
+                if (other.stride != stride) {
+                    throw std::invalid_argument("Cannot merge changes of boards of different sizes");
+                }
+                for (size_t i = 0; i < dirty.size(); ++i) {
+                    dirty[i] |= other.dirty[i];
+                }
+                kinds |= other.kinds;
+            }
+
+            /**
+             * @return true if nothing was recorded
+             */
+            bool empty() const {return kinds == 0;}
+
+            /**
+             * @return true if a change of the kind was recorded
+             */
+            bool has(Kind kind) const {return (kinds & kind) != 0;}
+
+            /**
+             * @return every recorded kind as flags
+             */
+            unsigned getKinds() const {return kinds;}
+
+            /**
+             * @return rows and columns of the board, walls included
+             */
+            int getStride() const {return stride;}
+
+            /**
+             * @return true if the square changed
+             */
+            bool isDirty(int row, int col) const {
+                int bit = row * stride + col;
+                return (dirty[bit / 64] >> (bit % 64)) & 1;
+            }
+
+            /**
+             * Calls f(row, col) for every changed square in row order
+             */
+            template<class F>
+            void forEachDirty(F f) const {
+                for (size_t word = 0; word < dirty.size(); ++word) {
+                    uint64_t bits = dirty[word];
+                    while (bits) {
+                        int bit = int(word * 64) + countTrailingZeros(bits);
+                        f(bit / stride, bit % stride);
+                        bits &= bits - 1;
+                    }
+                }
+            }
+
+        private:
+            int stride; // rows and columns, walls included
+            std::vector<uint64_t> dirty; // one bit per square, row major
+            unsigned kinds; // Kind flags
+
+            /**
+             * Index of the lowest set bit, bits must not be 0
+             */
+            static int countTrailingZeros(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+                return __builtin_ctzll(bits);
+#else
+                int count = 0;
+                while (!(bits & 1)) {
+                    bits >>= 1;
+                    ++count;
+                }
+                return count;
+#endif
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef BOARD_GEOMETRY_H
+#define BOARD_GEOMETRY_H
+
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @struct FixedGeometry
+     * Dimensions of a board with N playable rows and columns, known at compile time
+     *
+     * Loops over the board are written once as templates over a geometry. Instantiated
+     * with FixedGeometry their bounds and strides are constants the compiler can
+     * unroll and fold, instantiated with RuntimeGeometry they work for any size.
+     */
+    template<int N>
+    struct FixedGeometry {
+        static constexpr int SIZE = N; // playable rows and columns
+        static constexpr int STRIDE = N + 2; // squares per row, walls included
+
+        constexpr int size() const {return SIZE;}
+        constexpr int stride() const {return STRIDE;}
+    };
+
+    /**
+     * @struct RuntimeGeometry
+     * Dimensions of a board whose size is only known at run time
+     */
+    struct RuntimeGeometry {
+        int n; // playable rows and columns
+
+        int size() const {return n;}
+        int stride() const {return n + 2;}
+    };
+}
+
+#endif
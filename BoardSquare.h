@@ -1,5 +1,6 @@
 #ifndef BOARD_SQUARE_H
 #define BOARD_SQUARE_H
+#include <cstdint>
 #include <cstring>  
 #include <stdexcept>  
 #include <algorithm> 
@@ -37,84 +38,94 @@ namespace Paintbots{
 
     /**
      * @class Base class for InternalBoardSquare and ExternalBoardSquare
+     * 
+     * The whole state of a square is packed into a single byte, so a board is a 
+     * small, trivially copyable block of memory: 
+     *   bits 0-1 color, bits 2-3 type, bit 4 red robot, bit 5 blue robot, bits 6-7 facing 
      */
     class BoardSquare{
         protected: 
-            SquareColor squareColor; // keep track of square color 
-            bool hasRedRobot; // keep track if a square has a red robot 
-            bool hasBlueRobot; // keep track if a square has a blue robot 
-            Direction robotFacing; // keep track of the direction the robot is facing 
-            SquareType squareType; // keep track of the different square types 
+            uint8_t state; // packed color, type, robots and facing 
+
+            static const uint8_t COLOR_SHIFT = 0; 
+            static const uint8_t TYPE_SHIFT = 2; 
+            static const uint8_t RED_ROBOT_BIT = 1 << 4; 
+            static const uint8_t BLUE_ROBOT_BIT = 1 << 5; 
+            static const uint8_t FACING_SHIFT = 6; 
+            static const uint8_t FIELD_MASK = 3; // two bit fields 
+
+            /**
+             * Builds the packed byte from the individual values 
+             */
+            static uint8_t pack(SquareColor color, bool redRobot, bool blueRobot, 
+                                Direction direction, SquareType type) {
+                return static_cast<uint8_t>(((color & FIELD_MASK) << COLOR_SHIFT) | 
+                                            ((type & FIELD_MASK) << TYPE_SHIFT) | 
+                                            (redRobot ? RED_ROBOT_BIT : 0) | 
+                                            (blueRobot ? BLUE_ROBOT_BIT : 0) | 
+                                            ((direction & FIELD_MASK) << FACING_SHIFT)); 
+            }
+
+            /**
+             * Replaces a two bit field 
+             */
+            void storeField(uint8_t shift, int value) {
+                state = static_cast<uint8_t>((state & ~(FIELD_MASK << shift)) | ((value & FIELD_MASK) << shift)); 
+            }
+
+            /**
+             * Sets or clears a single bit 
+             */
+            void storeFlag(uint8_t bit, bool set) {
+                state = static_cast<uint8_t>(set ? (state | bit) : (state & ~bit)); 
+            }
 
         public: 
             // default constructor
             BoardSquare(): 
-                squareColor(WHITE), 
-                hasRedRobot(false), 
-                hasBlueRobot(false), 
-                robotFacing(NORTH), 
-                squareType(EMPTY) {}
+                state(pack(WHITE, false, false, NORTH, EMPTY)) {}
 
 
             // specific constructor 
             BoardSquare(SquareColor color, bool redRobot, bool blueRobot, 
                    Direction direction, SquareType type) :
-                squareColor(color),
-                hasRedRobot(redRobot),
-                hasBlueRobot(blueRobot),
-                robotFacing(direction),
-                squareType(type) {}
-
-            // Copy Constructor 
-            BoardSquare(const BoardSquare& other) : 
-                squareColor(other.squareColor), 
-                hasRedRobot(other.hasRedRobot), 
-                hasBlueRobot(other.hasBlueRobot), 
-                robotFacing(other.robotFacing), 
-                squareType(other.squareType) {}
-
-            
-            // assignment operator
-            BoardSquare& operator=(const BoardSquare& other){
-                if (this != &other){
-                    squareColor = other.squareColor; 
-                    hasRedRobot = other.hasRedRobot; 
-                    hasBlueRobot = other.hasBlueRobot; 
-                    robotFacing = other.robotFacing; 
-                    squareType = other.squareType; 
-                }
-                return *this; 
-            }
+                state(pack(color, redRobot, blueRobot, direction, type)) {}
+
+            // copying is a plain byte copy 
+            BoardSquare(const BoardSquare& other) = default; 
+            BoardSquare& operator=(const BoardSquare& other) = default; 
 
-            // virtual deconstructor 
-            virtual ~BoardSquare(){}
+            /**
+             * Gets the packed state of the square, see the class comment for the layout 
+             */
+            inline uint8_t packedState() const {return state;}
 
             //inline getters 
 
             /**
              * Gets color of the square 
              */
-            inline SquareColor getSquareColor() const {return squareColor;}
+            inline SquareColor getSquareColor() const {return static_cast<SquareColor>((state >> COLOR_SHIFT) & FIELD_MASK);}
 
             /**
              * Gets type of the square 
              */
-            inline SquareType getSquareType() const {return squareType;}
+            inline SquareType getSquareType() const {return static_cast<SquareType>((state >> TYPE_SHIFT) & FIELD_MASK);}
 
             /**
              * @return true if red robot is present in a square 
              */
-            inline bool redRobotPresent() const {return hasRedRobot;}
+            inline bool redRobotPresent() const {return (state & RED_ROBOT_BIT) != 0;}
 
             /**
              * @return true if blue robot is present in a square 
              */
-            inline bool blueRobotPresent() const {return hasBlueRobot;}
+            inline bool blueRobotPresent() const {return (state & BLUE_ROBOT_BIT) != 0;}
 
             /**
              * Returns the direction the robot is facing towards
              */
-            inline Direction robotDirection() const {return robotFacing;}
+            inline Direction robotDirection() const {return static_cast<Direction>((state >> FACING_SHIFT) & FIELD_MASK);}
     };
 }
 
@@ -144,6 +144,38 @@ namespace Paintbots{
         std::cout << "RobotDirection test: PASS\n";
     }
 
+    /**
+     * @test Tests that all fields are stored independently in the packed byte 
+     */
+    void BoardSquareTest::testPackedState() {
+        assert(sizeof(BoardSquare) == 1);
+
+        SquareColor colors[] = {RED, BLUE, WHITE};
+        SquareType types[] = {EMPTY, ROCK, FOG, WALL};
+        Direction directions[] = {NORTH, SOUTH, EAST, WEST};
+        bool seen[256] = {false};
+
+        for (SquareColor color : colors) {
+            for (SquareType type : types) {
+                for (Direction direction : directions) {
+                    for (int robots = 0; robots < 3; ++robots) {
+                        BoardSquare square(color, robots == 1, robots == 2, direction, type);
+                        assert(square.getSquareColor() == color);
+                        assert(square.getSquareType() == type);
+                        assert(square.robotDirection() == direction);
+                        assert(square.redRobotPresent() == (robots == 1));
+                        assert(square.blueRobotPresent() == (robots == 2));
+
+                        // Distinct squares never share a packed value
+                        assert(!seen[square.packedState()]);
+                        seen[square.packedState()] = true;
+                    }
+                }
+            }
+        }
+        std::cout << "Packed state test: PASS\n";
+    }
+
     bool BoardSquareTest::doTests() {
         bool allTestsPassed = true;
         try {
@@ -160,6 +192,7 @@ namespace Paintbots{
             testRedRobotPresent();
             testBlueRobotPresent();
             testRobotDirection();
+            testPackedState();
             
         } catch (const std::exception& e) {
             std::cout << "Test failed with exception: " << e.what() << std::endl;
@@ -56,6 +56,11 @@ namespace Paintbots{
              * Tests whether getter returns a correct robot direction 
              */
             void testRobotDirection(); 
+
+            /**
+             * Tests that every combination of fields survives the packing into one byte 
+             */
+            void testPackedState(); 
         
         public: 
 
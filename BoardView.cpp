@@ -0,0 +1,49 @@
+#include "BoardView.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * Remembers the board and its version, copies nothing yet
+     */
+    BoardView::BoardView(const GameBoard& board, GameBoard::LongRangeScan& buffer) :
+        board(&board),
+        buffer(&buffer),
+        version(board.getVersion()),
+        materialized(false) {}
+
+    /**
+     * Views outlive a turn only by mistake, reading them afterwards is an error
+     */
+    void BoardView::checkVersion() const {
+        if (board->getVersion() != version) {
+            throw std::logic_error("Board view read after the board changed");
+        }
+    }
+
+    /**
+     * Copies the one square asked for
+     */
+    ExternalBoardSquare BoardView::at(int row, int col) const {
+        int size = this->size();
+        if (row < 0 || row >= size || col < 0 || col >= size) {
+            throw std::out_of_range("Board view position out of range");
+        }
+        checkVersion();
+        return ExternalBoardSquare(board->getSquare(row, col));
+    }
+
+    /**
+     * Fills the buffer the first time, later calls return the same rows
+     */
+    ExternalBoardSquare** BoardView::rows() {
+        checkVersion();
+        if (!materialized) {
+            board->getLongRangeScan(*buffer);
+            materialized = true;
+        }
+        return buffer->rowPointers();
+    }
+}
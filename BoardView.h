@@ -0,0 +1,65 @@
+#ifndef BOARD_VIEW_H
+#define BOARD_VIEW_H
+
+#include "GameBoard.h"
+#include "ExternalBoardSquare.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class BoardView
+     * Read only long range view of a board that copies squares only when they are read
+     *
+     * Reading single squares through at() copies nothing else; the legacy jagged array
+     * from rows() is filled into the caller's buffer on first use. The view remembers
+     * the board's version when it was made and refuses to read once the board changed,
+     * so it cannot show a mix of two turns.
+     */
+    class BoardView {
+        public:
+            /**
+             * Views a board, the buffer is only written if rows() is called
+             */
+            BoardView(const GameBoard& board, GameBoard::LongRangeScan& buffer);
+
+            /**
+             * @return rows and columns of the view, walls included
+             */
+            int size() const {return board->getSize() + 2;}
+
+            /**
+             * Reads one square, walls at rows and columns 0 and size() - 1
+             * @throws std::out_of_range outside the board
+             * @throws std::logic_error if the board changed since the view was made
+             */
+            ExternalBoardSquare at(int row, int col) const;
+
+            /**
+             * Gets the whole board as a jagged array, filling the buffer on first use
+             * @throws std::logic_error if the board changed since the view was made
+             */
+            ExternalBoardSquare** rows();
+
+            /**
+             * @return true once rows() copied the whole board
+             */
+            bool isMaterialized() const {return materialized;}
+
+        private:
+            const GameBoard* board; // board being viewed
+            GameBoard::LongRangeScan* buffer; // storage for rows()
+            uint64_t version; // board version the view belongs to
+            bool materialized; // buffer holds the board
+
+            /**
+             * Throws if the board changed after the view was made
+             */
+            void checkVersion() const;
+    };
+}
+
+#endif
@@ -22,7 +22,11 @@ namespace Paintbots {
         rockUpperBound(20),
         fogLowerBound(5),
         fogUpperBound(10),
-        longRangeLimit(30) {}
+        longRangeLimit(30),
+        boardSize(15),
+        moveTimeLimit(0),
+        seed(0),
+        seedSet(false) {}
 
     /**
      * Gets default singleton instance 
@@ -113,6 +117,20 @@ namespace Paintbots {
 
             std::transform(key.begin(), key.end(), key.begin(), ::toupper);
 
+            // Seeds span the whole 64 bit range and may be zero
+            if (key == "SEED") {
+                if (value.find_first_not_of("0123456789") != std::string::npos) {
+                    throw ConfigValueError("Non-numeric value for key 'SEED': " + value);
+                }
+                try {
+                    seed = std::stoull(value);
+                    seedSet = true;
+                } catch (const std::out_of_range&) {
+                    throw ConfigValueError("Value out of range for key 'SEED': " + value);
+                }
+                continue;
+            }
+
             try {
                 int intValue = std::stoi(value);
                 if (intValue <= 0) {
@@ -126,6 +144,8 @@ namespace Paintbots {
                 else if (key == "FOG_LOWER_BOUND") fogLowerBound = intValue;
                 else if (key == "FOG_UPPER_BOUND") fogUpperBound = intValue;
                 else if (key == "LONG_RANGE_LIMIT") longRangeLimit = intValue;
+                else if (key == "MOVE_TIME_LIMIT_US") moveTimeLimit = intValue;
+                else if (key == "BOARD_SIZE") setBoardSize(intValue);
                 else throw ConfigFormatError("Unknown configuration key: " + key);
                 
             } catch (const std::invalid_argument&) {
@@ -180,4 +200,62 @@ namespace Paintbots {
      * return the long range scan limit 
      */
     int Config::getLongRangeLimit() const {return longRangeLimit;}
+
+    /**
+     * set the long range scan limit 
+     */
+    void Config::setLongRangeLimit(int scans) {
+        if (scans < 0) {
+            throw ConfigValueError("Negative long range limit: " + std::to_string(scans));
+        }
+        longRangeLimit = scans;
+    }
+
+    /**
+     * return the board size 
+     */
+    int Config::getBoardSize() const {return boardSize;}
+
+    /**
+     * set the board size 
+     */
+    void Config::setBoardSize(int size) {
+        if (size <= 0) {
+            throw ConfigValueError("Board size must be positive: " + std::to_string(size));
+        }
+        boardSize = size;
+    }
+
+    /**
+     * return the per move time budget in microseconds 
+     */
+    int Config::getMoveTimeLimit() const {return moveTimeLimit;}
+
+    /**
+     * set the per move time budget 
+     */
+    void Config::setMoveTimeLimit(int microseconds) {
+        if (microseconds < 0) {
+            throw ConfigValueError("Negative move time limit: " + std::to_string(microseconds));
+        }
+        moveTimeLimit = microseconds;
+    }
+
+    /**
+     * return whether a match seed was configured 
+     */
+    bool Config::hasSeed() const {return seedSet;}
+
+    /**
+     * return the configured match seed 
+     */
+    uint64_t Config::getSeed() const {return seed;}
+
+    /**
+     * set the match seed 
+     */
+    void Config::setSeed(uint64_t matchSeed) {
+        seed = matchSeed;
+        seedSet = true;
+    }
 }
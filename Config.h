@@ -2,6 +2,7 @@
 #define CONFIG_H 
 
 #include <string> 
+#include <cstdint>
 #include <cstring>  
 #include <stdexcept>  
 #include <algorithm> 
@@ -10,10 +11,11 @@ namespace Paintbots{
 
     /**
      * @class Config 
-     * Singleton class managing game configuration parameters 
+     * Value class managing game configuration parameters 
      * 
      * Handles reading and storing game setting from config files. In case of absence of 
-     * values, it provides default values 
+     * values, it provides default values. Configs are cheap to copy, so every board keeps 
+     * its own; the singleton accessors remain for the legacy entry points 
      */
     class Config{
 
@@ -27,15 +29,27 @@ namespace Paintbots{
             int fogLowerBound; // min number of fog squares
             int fogUpperBound; // max number of fog squares
             int longRangeLimit; // maximum number of long range scans 
+            int boardSize; // playable rows and columns of the board 
+            int moveTimeLimit; // microseconds an agent may think per move, 0 for no limit 
+            uint64_t seed; // match seed, only meaningful if seedSet 
+            bool seedSet; // whether a seed was configured 
 
-            // Private constructor for singleton 
+        public: 
+
+            /**
+             * Creates a config holding the default values 
+             */
             Config(); 
-            Config(const std::string& configFile); 
-            Config(const Config&) = delete; 
-            Config& operator = (const Config&) = delete; 
 
-        
-        public: 
+            /**
+             * Creates a config from a file, falling back to defaults for missing keys 
+             * @param configFile: path to configuration file 
+             * @throws std::runtime_error on file or parsing errors 
+             */
+            explicit Config(const std::string& configFile); 
+
+            Config(const Config&) = default; 
+            Config& operator = (const Config&) = default; 
 
             /**
              * Gets singleton instance with default config 
@@ -91,6 +105,46 @@ namespace Paintbots{
              */
             int getLongRangeLimit() const; 
 
+            /**
+             * Sets the number of long range scans each robot may request per match 
+             */
+            void setLongRangeLimit(int scans); 
+
+            /**
+             * return the number of playable rows and columns of a board 
+             */
+            int getBoardSize() const; 
+
+            /**
+             * Sets the number of playable rows and columns of a board 
+             */
+            void setBoardSize(int size); 
+
+            /**
+             * return the per move time budget of an agent in microseconds, 0 if unlimited 
+             */
+            int getMoveTimeLimit() const; 
+
+            /**
+             * Sets the per move time budget, 0 to let agents think as long as they like 
+             */
+            void setMoveTimeLimit(int microseconds); 
+
+            /**
+             * @return true if a match seed was given in the file or set afterwards 
+             */
+            bool hasSeed() const; 
+
+            /**
+             * return the configured match seed 
+             */
+            uint64_t getSeed() const; 
+
+            /**
+             * Sets the match seed, e.g. from the command line 
+             */
+            void setSeed(uint64_t matchSeed); 
+
     }; 
 }
 
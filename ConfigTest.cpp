@@ -377,6 +377,52 @@ void ConfigTest::testConfigSingleton() {
     std::cout << "Config singleton test: PASS\n";
 }
 
+/**
+ * @test Testing that the match seed is read as a full 64 bit value and validated 
+ */
+void ConfigTest::testSeed() {
+    Config unseeded;
+    assert(!unseeded.hasSeed());
+
+    createTestFile("seed.txt", "SEED = 18446744073709551615\n");
+    Config seeded("seed.txt");
+    assert(seeded.hasSeed());
+    assert(seeded.getSeed() == 18446744073709551615ULL);
+
+    seeded.setSeed(42);
+    assert(seeded.getSeed() == 42);
+
+    createTestFile("bad_seed.txt", "SEED = -5\n");
+    try {
+        Config bad("bad_seed.txt");
+        assert(false && "Should throw exception for a negative seed");
+    } catch (const std::runtime_error&) {
+    }
+    std::remove("seed.txt");
+    std::remove("bad_seed.txt");
+    std::cout << "Seed test: PASS\n";
+}
+
+/**
+ * @test Testing that the move time limit defaults to unlimited and is read from the file 
+ */
+void ConfigTest::testMoveTimeLimit() {
+    Config defaults;
+    assert(defaults.getMoveTimeLimit() == 0);
+
+    createTestFile("time_limit.txt", "MOVE_TIME_LIMIT_US = 2500\n");
+    Config limited("time_limit.txt");
+    assert(limited.getMoveTimeLimit() == 2500);
+
+    try {
+        limited.setMoveTimeLimit(-1);
+        assert(false && "Should throw exception for a negative limit");
+    } catch (const std::runtime_error&) {
+    }
+    std::remove("time_limit.txt");
+    std::cout << "Move time limit test: PASS\n";
+}
+
 bool ConfigTest::doTests() {
     bool allTestsPassed = true;
     try {
@@ -407,6 +453,8 @@ bool ConfigTest::doTests() {
         testRockFogConflict();
         testBoardManipulation();
         testConfigSingleton();
+        testSeed();
+        testMoveTimeLimit();
         
     } catch (const std::exception& e) {
         std::cout << "Test failed with exception: " << e.what() << std::endl;
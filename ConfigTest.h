@@ -38,6 +38,8 @@ namespace Paintbots {
         void testRockFogConflict();
         void testBoardManipulation();
         void testConfigSingleton();
+        void testSeed();
+        void testMoveTimeLimit();
 
     public:
         bool doTests() override;
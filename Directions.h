@@ -0,0 +1,52 @@
+#ifndef DIRECTIONS_H
+#define DIRECTIONS_H
+
+#include "BoardSquare.h"
+
+namespace Paintbots {
+
+    /**
+     * Lookup tables for turning and stepping, indexed by Direction. Rows grow to the
+     * south and columns to the east, like the board
+     */
+    constexpr int ROW_STEP[4] = {-1, 1, 0, 0}; // NORTH, SOUTH, EAST, WEST
+    constexpr int COL_STEP[4] = {0, 0, 1, -1};
+    constexpr Direction LEFT_OF[4] = {WEST, EAST, NORTH, SOUTH};
+    constexpr Direction RIGHT_OF[4] = {EAST, WEST, SOUTH, NORTH};
+    constexpr Direction OPPOSITE_OF[4] = {SOUTH, NORTH, WEST, EAST};
+    constexpr int CLOCKWISE_INDEX[4] = {0, 2, 1, 3}; // position when turning right from NORTH
+
+    /**
+     * @return the direction after a ROTATELEFT
+     */
+    constexpr Direction rotateLeft(Direction facing) {return LEFT_OF[facing];}
+
+    /**
+     * @return the direction after a ROTATERIGHT
+     */
+    constexpr Direction rotateRight(Direction facing) {return RIGHT_OF[facing];}
+
+    /**
+     * @return the direction behind
+     */
+    constexpr Direction opposite(Direction facing) {return OPPOSITE_OF[facing];}
+
+    /**
+     * @return rows moved by one step forward
+     */
+    constexpr int rowStep(Direction facing) {return ROW_STEP[facing];}
+
+    /**
+     * @return columns moved by one step forward
+     */
+    constexpr int colStep(Direction facing) {return COL_STEP[facing];}
+
+    /**
+     * @return ROTATERIGHT moves needed to turn from one direction to another, 0 to 3
+     */
+    constexpr int turnsRight(Direction from, Direction to) {
+        return (CLOCKWISE_INDEX[to] - CLOCKWISE_INDEX[from] + 4) % 4;
+    }
+}
+
+#endif
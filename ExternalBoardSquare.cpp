@@ -10,10 +10,6 @@ namespace Paintbots{
      * Constructor based on BoardSquare constructor 
      */
 ExternalBoardSquare::ExternalBoardSquare(const InternalBoardSquare& square):
-    BoardSquare(square.getSquareColor(), 
-                square.redRobotPresent(), 
-                square.blueRobotPresent(), 
-                square.robotDirection(), 
-                square.getSquareType()) {}
+    BoardSquare(square) {}
 
 }
\ No newline at end of file
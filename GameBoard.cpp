@@ -1,4 +1,9 @@
 #include "GameBoard.h"
+#include "Profiler.h"
+#include "ConfigError.h"
+#include "LayoutCorpus.h"
+#include "BoardGeometry.h"
+#include "Directions.h"
 #include <stdexcept> 
 #include <random> 
 #include <ctime> 
@@ -9,40 +14,89 @@
 
 namespace Paintbots{
 
+    namespace {
+        /**
+         * Builds the square short range scans show past the outer walls 
+         */
+        InternalBoardSquare makeWall() {
+            InternalBoardSquare wall; 
+            wall.setType(WALL); 
+            return wall; 
+        }
+    }
+
     GameBoard* GameBoard::instance = nullptr; 
     const std::string GameBoard::PASSWORD = "xyzzy"; 
+    const InternalBoardSquare GameBoard::WALL_SENTINEL = makeWall(); 
+
+    /**
+     * Default constructor, uses the default configuration values 
+     */
+    GameBoard::GameBoard() : GameBoard(Config()) {}
+
 
     /**
-     * Default constructor 
+     * Copies the Config object and initializes a board 
      */
-    GameBoard::GameBoard() : 
+    GameBoard::GameBoard(const Config& config) : 
         redRobotPaintColor(RED),
         blueRobotPaintColor(BLUE),
-        config(Config::getInstance()),
+        size(config.getBoardSize()),
+        grid(size_t(size + 2) * (size + 2)),
+        config(config),
+        seed(config.hasSeed() ? config.getSeed() : MatchSeed::random().value()),
         redPaintBlobsRemaining(config.getPaintBlobLimit()),
         bluePaintBlobsRemaining(config.getPaintBlobLimit()),
         redRobotHitDuration(0),
-        blueRobotHitDuration(0) {
+        blueRobotHitDuration(0),
+        version(0),
+        layers(size),
+        squaresStale(false),
+        pending(size + 2),
+        delivered(size + 2),
+        batchDepth(0) {
         initializeBoard();
     }
 
-
     /**
-     * Takes a reference to a Config object and initializes a board 
+     * Builds the board from a layout record instead of generating it. The layout's 
+     * seed replaces the config's, so the agents are seeded as in the original match 
      */
-    GameBoard::GameBoard(const Config& config) : 
+    GameBoard::GameBoard(const Config& config, const BoardLayout& layout) : 
         redRobotPaintColor(RED),
         blueRobotPaintColor(BLUE),
-        config(const_cast<Config&>(config)),
+        size(layout.size),
+        grid(size_t(size + 2) * (size + 2)),
+        config(config),
+        seed(layout.seed),
         redPaintBlobsRemaining(config.getPaintBlobLimit()),
         bluePaintBlobsRemaining(config.getPaintBlobLimit()),
         redRobotHitDuration(0),
-        blueRobotHitDuration(0) {
-        initializeBoard();
+        blueRobotHitDuration(0),
+        version(0),
+        layers(size),
+        squaresStale(false),
+        pending(size + 2),
+        delivered(size + 2),
+        batchDepth(0) {
+        this->config.setSeed(layout.seed); 
+        this->config.setBoardSize(layout.size); 
+        placeWalls(); 
+        const uint8_t* squares = layout.squares; 
+        for (int i = 1; i <= size; ++i) {
+            for (int j = 1; j <= size; ++j) {
+                cell(i, j).setPackedState(*squares++); 
+            }
+        }
+        rescanBoard(); 
+        if (redPosition.row == -1 || bluePosition.row == -1) {
+            throw std::invalid_argument("Board layout is missing a robot"); 
+        }
     }
 
     /**
-     * Gets GameBoard instance by passing in the password 
+     * Gets the shared GameBoard instance by passing in the password. Kept for the 
+     * legacy entry points, new code should create its own boards 
      */
     GameBoard* GameBoard::getInstance(const std::string& password){
         if (password.empty() || password != PASSWORD){
@@ -64,190 +118,250 @@ namespace Paintbots{
         if (instance == this) {
             instance = nullptr;
         }
-        
-        for (Observer* observer : getObservers()) {
-            removeObserver(observer);
-        }
     }
 
     /**
      * Places walls, rocks, fog and robots on the board 
      */
     void GameBoard::initializeBoard(){
+        checkLayoutFeasible(); 
         placeWalls(); 
-        placeRocks(); 
-        placeFog(); 
-        placeRobots(); 
+        placeContents(); 
+        rescanBoard(); 
     }
 
     /**
      * Function to place walls on the board 
      */
     void GameBoard::placeWalls() {
-        for (int i = 0; i < BOARD_SIZE + 2; ++i) {
-            board[0][i].setType(WALL);
-            board[BOARD_SIZE + 1][i].setType(WALL);
-            board[i][0].setType(WALL);
-            board[i][BOARD_SIZE + 1].setType(WALL);
+        for (int i = 0; i < size + 2; ++i) {
+            cell(0, i).setType(WALL);
+            cell(size + 1, i).setType(WALL);
+            cell(i, 0).setType(WALL);
+            cell(i, size + 1).setType(WALL);
         }
     }
 
     /**
-     * Function to place rocks on the board 
+     * Checks that the board size is supported and that the configured rocks, fog and 
+     * both robots always fit on the board, so generation cannot run out of squares 
      */
-    void GameBoard::placeRocks(){
-        std::random_device rd; 
-        std::mt19937 gen(rd()); 
-        std::uniform_int_distribution<> rowDist(1, BOARD_SIZE); 
-        std::uniform_int_distribution<>colDist(1, BOARD_SIZE); 
-
-        int numRocks = std::uniform_int_distribution<>(
-            config.getRockLowerBound(), 
-            config.getRockUpperBound()
-        )(gen); 
-
-        for (int i = 0; i < numRocks; ++i){
-            int row = rowDist(gen); 
-            int col = colDist(gen); 
-            if (board[row][col].getSquareType() == EMPTY){
-                board[row][col].setType(ROCK); 
-            } else {
-                --i; 
-            }
+    void GameBoard::checkLayoutFeasible() const {
+        if (size > MAX_SIZE) {
+            throw ConfigBoundsError("Board size " + std::to_string(size) + " is above the maximum of " + 
+                                    std::to_string(MAX_SIZE));
+        }
+        int pieces = config.getRockUpperBound() + config.getFogUpperBound() + 2;
+        if (pieces > size * size) {
+            throw ConfigBoundsError("Up to " + std::to_string(config.getRockUpperBound()) + 
+                                    " rocks, " + std::to_string(config.getFogUpperBound()) + 
+                                    " fog squares and 2 robots do not fit on a " + 
+                                    std::to_string(size) + "x" + std::to_string(size) + 
+                                    " board");
         }
     }
 
     /**
-     * Function to place fog on the board 
+     * Places rocks, fog and robots in one pass. The playable squares are partially 
+     * shuffled just far enough to cover every piece, then handed out in order, so 
+     * each piece lands on a distinct empty square without any retries 
      */
-    void GameBoard::placeFog(){
-        std::random_device rd; 
-        std::mt19937 gen(rd()); 
-        std::uniform_int_distribution<> rowDist(1, BOARD_SIZE); 
-        std::uniform_int_distribution<> colDist(1, BOARD_SIZE); 
+    void GameBoard::placeContents() {
+        MatchSeed matchSeed(seed);
+        std::mt19937_64 rockGen(matchSeed.derive(MatchSeed::ROCKS)); 
+        std::mt19937_64 fogGen(matchSeed.derive(MatchSeed::FOG)); 
+        std::mt19937_64 gen(matchSeed.derive(MatchSeed::LAYOUT)); 
 
-        int numFog = std::uniform_int_distribution<> (  
+        int numRocks = std::uniform_int_distribution<>(
+            config.getRockLowerBound(), 
+            config.getRockUpperBound()
+        )(rockGen); 
+        int numFog = std::uniform_int_distribution<>(
             config.getFogLowerBound(), 
             config.getFogUpperBound()
-        )(gen);
-
+        )(fogGen); 
 
-        for (int i = 0; i < numFog; ++i){
-            int row = rowDist(gen); 
-            int col = colDist(gen); 
-            if (board[row][col].getSquareType() == EMPTY){
-                board[row][col].setType(FOG); 
-            } else {
-                --i; 
-            }
+        const int cellCount = size * size; 
+        std::vector<int> cells(cellCount); 
+        for (int i = 0; i < cellCount; ++i) {
+            cells[i] = i; 
         }
-    }
-
-    /**
-     * Function to place robots on the board 
-     */
-    void GameBoard::placeRobots() {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> rowDist(1, BOARD_SIZE);
-        std::uniform_int_distribution<> colDist(1, BOARD_SIZE);
-
-        // Placing red robot
-        int redRobotPlaced = 0;
-        while (redRobotPlaced == 0) {
-            int row = rowDist(gen);
-            int col = colDist(gen);
-            if (board[row][col].getSquareType() == EMPTY && 
-                !board[row][col].redRobotPresent() && 
-                !board[row][col].blueRobotPresent()) {
-                
-                board[row][col].setRedRobot(true);
-                board[row][col].setRobotDirection(NORTH);  // Default direction
-                board[row][col].setSquareColor(WHITE);     // Ensure initial square color is white
-                
-                std::cout << "Red robot placed at (" << row << ", " << col << ")" << std::endl;
-                redRobotPlaced = 1;
-            }
+        int pieces = numRocks + numFog + 2; 
+        for (int i = 0; i < pieces; ++i) {
+            int pick = std::uniform_int_distribution<>(i, cellCount - 1)(gen); 
+            std::swap(cells[i], cells[pick]); 
         }
 
-        // Placing blue robot
-        int blueRobotPlaced = 0;
-        while (blueRobotPlaced == 0) {
-            int row = rowDist(gen);
-            int col = colDist(gen);
-            if (board[row][col].getSquareType() == EMPTY && 
-                !board[row][col].redRobotPresent() && 
-                !board[row][col].blueRobotPresent()) {
-                
-                board[row][col].setBlueRobot(true);
-                board[row][col].setRobotDirection(NORTH);  // Default direction
-                board[row][col].setSquareColor(WHITE);     // Ensure initial square color is white
-                
-                std::cout << "Blue robot placed at (" << row << ", " << col << ")" << std::endl;
-                blueRobotPlaced = 1;
-            }
+        int next = 0; 
+        for (int i = 0; i < numRocks; ++i, ++next) {
+            cell(cells[next] / size + 1, cells[next] % size + 1).setType(ROCK); 
         }
-
-        // Additional debug logging to confirm robot placement
-        for (int i = 1; i <= BOARD_SIZE; ++i) {
-            for (int j = 1; j <= BOARD_SIZE; ++j) {
-                if (board[i][j].redRobotPresent()) {
-                    std::cout << "Verification: Red robot at (" << i << ", " << j << ")" << std::endl;
-                }
-                if (board[i][j].blueRobotPresent()) {
-                    std::cout << "Verification: Blue robot at (" << i << ", " << j << ")" << std::endl;
-                }
-            }
+        for (int i = 0; i < numFog; ++i, ++next) {
+            cell(cells[next] / size + 1, cells[next] % size + 1).setType(FOG); 
         }
+
+        int row = cells[next] / size + 1; 
+        int col = cells[next] % size + 1; 
+        cell(row, col).setRedRobot(true);
+        cell(row, col).setRobotDirection(NORTH);  // Default direction
+        cell(row, col).setSquareColor(WHITE);     // Ensure initial square color is white
+        redPosition = {row, col, NORTH};
+
+        ++next; 
+        row = cells[next] / size + 1; 
+        col = cells[next] % size + 1; 
+        cell(row, col).setBlueRobot(true);
+        cell(row, col).setRobotDirection(NORTH);
+        cell(row, col).setSquareColor(WHITE);
+        bluePosition = {row, col, NORTH};
     }
 
     /**
      * Method to check is a postion is valid for placing a robot 
      */
     bool GameBoard::isValidPosition(int row, int col) const {
-        return row>=0 && row < BOARD_SIZE + 2 && 
-                col >= 0 && col < BOARD_SIZE + 2; 
+        return row>=0 && row < size + 2 && 
+                col >= 0 && col < size + 2; 
     }
 
     /**
-     * Method that returns a square 
+     * Method that returns a square. The caller may move robots around through it, 
+     * so the cached positions are rescanned on the next lookup 
      */
     InternalBoardSquare& GameBoard::getSquare(int row, int col){
         if (!isValidPosition(row, col)){
             throw std::out_of_range("Invalid board position"); 
         } 
 
-        return board[row][col]; 
+        squaresStale = true; 
+        ++version; 
+        markChanged(row, col); 
+        return cell(row, col); 
     }
 
     /**
-     * Performs a the requested move on the designated robot  
+     * Method that returns a square for reading 
      */
-    bool GameBoard::moveRobot(RobotMoveRequest& mr) {
-        // Find current robot position and direction
-        int robotRow = -1, robotCol = -1;
-        Direction robotDir;
-        
-        // Find the robot's position and direction
-        for (int i = 1; i <= BOARD_SIZE; ++i) {
-            for (int j = 1; j <= BOARD_SIZE; ++j) {
-                if ((mr.robot == RobotMoveRequest::RED && board[i][j].redRobotPresent()) || 
-                    (mr.robot == RobotMoveRequest::BLUE && board[i][j].blueRobotPresent())) {
-                    robotRow = i;
-                    robotCol = j;
-                    robotDir = board[i][j].robotDirection();
-                    break;
+    const InternalBoardSquare& GameBoard::getSquare(int row, int col) const {
+        if (!isValidPosition(row, col)){
+            throw std::out_of_range("Invalid board position"); 
+        } 
+
+        return cell(row, col); 
+    }
+
+    /**
+     * Finds both robots and counts the colors in one pass. The first square in row 
+     * order wins if a robot was placed more than once 
+     */
+    template<class Geometry>
+    void GameBoard::rescanSquares(Geometry geometry) const {
+        redPosition.row = -1; 
+        bluePosition.row = -1; 
+        layers.clear(); 
+
+        for (int i = 1; i <= geometry.size(); ++i) {
+            const InternalBoardSquare* row = &grid[i * geometry.stride()]; 
+            for (int j = 1; j <= geometry.size(); ++j) {
+                const InternalBoardSquare& square = row[j]; 
+                if (redPosition.row == -1 && square.redRobotPresent()) {
+                    redPosition = {i, j, square.robotDirection()};
+                }
+                if (bluePosition.row == -1 && square.blueRobotPresent()) {
+                    bluePosition = {i, j, square.robotDirection()};
                 }
+                layers.set(BitBoard::RED_LAYER, i, j, square.getSquareColor() == RED); 
+                layers.set(BitBoard::BLUE_LAYER, i, j, square.getSquareColor() == BLUE); 
+                layers.set(BitBoard::ROCK_LAYER, i, j, square.getSquareType() == ROCK); 
+                layers.set(BitBoard::FOG_LAYER, i, j, square.getSquareType() == FOG); 
+                layers.set(BitBoard::WALL_LAYER, i, j, square.getSquareType() == WALL); 
             }
-            if (robotRow != -1) break;
         }
 
-        // If robot not found, throw appropriate error
-        if (robotRow == -1) {
+        squaresStale = false; 
+    }
+
+    /**
+     * Default sized boards take the loop with constant bounds 
+     */
+    void GameBoard::rescanBoard() const {
+        if (size == BOARD_SIZE) {
+            rescanSquares(FixedGeometry<BOARD_SIZE>()); 
+        } else {
+            rescanSquares(RuntimeGeometry{size}); 
+        }
+    }
+
+    /**
+     * Colors a square and moves it between the paint layers. The layers only 
+     * cover the squares inside the walls, so painted walls do not score 
+     */
+    void GameBoard::paintSquare(int row, int col, SquareColor color) {
+        if (squaresStale) {
+            rescanBoard(); 
+        }
+
+        cell(row, col).setSquareColor(color); 
+        markChanged(row, col); 
+        layers.set(BitBoard::RED_LAYER, row, col, color == RED); 
+        layers.set(BitBoard::BLUE_LAYER, row, col, color == BLUE); 
+    }
+
+    /**
+     * Gets the bitboard layers, rebuilding them if squares were handed out 
+     */
+    const BitBoard& GameBoard::getBitBoard() const {
+        if (squaresStale) {
+            rescanBoard(); 
+        }
+        return layers; 
+    }
+
+    /**
+     * Gets the cached position of a robot 
+     */
+    GameBoard::RobotPosition& GameBoard::robotPosition(RobotMoveRequest::RobotColor robot) {
+        if (squaresStale) {
+            rescanBoard(); 
+        }
+
+        if (robot != RobotMoveRequest::RED && robot != RobotMoveRequest::BLUE) {
             throw std::runtime_error("Robot not found on board");
         }
 
-        InternalBoardSquare& currentSquare = board[robotRow][robotCol];
+        RobotPosition& position = (robot == RobotMoveRequest::RED) ? redPosition : bluePosition; 
+        if (position.row == -1) {
+            throw std::runtime_error("Robot not found on board");
+        }
+        return position; 
+    }
+
+    /**
+     * Checks whether both robots ended up on the same square 
+     */
+    bool GameBoard::robotsCollided() const {
+        if (squaresStale) {
+            rescanBoard(); 
+        }
+
+        return redPosition.row != -1 && 
+               redPosition.row == bluePosition.row && 
+               redPosition.col == bluePosition.col; 
+    }
+
+    /**
+     * Performs a the requested move on the designated robot. Only moves that paint, 
+     * relocate or turn the robot change the version, so views stay valid otherwise 
+     */
+    bool GameBoard::moveRobot(RobotMoveRequest& mr) {
+        PAINTBOTS_PROFILE_SCOPE(Profiler::MOVE_ROBOT); 
+        // Look up the robot's position and direction
+        RobotPosition& position = robotPosition(mr.robot); 
+        int robotRow = position.row; 
+        int robotCol = position.col; 
+        Direction robotDir = position.facing; 
+
+        InternalBoardSquare& currentSquare = cell(robotRow, robotCol);
 
         // Update hit durations before move
         if (mr.robot == RobotMoveRequest::RED) {
@@ -255,7 +369,7 @@ namespace Paintbots{
                 redRobotHitDuration--;
                 if (redRobotHitDuration == 0) {
                     redRobotPaintColor = RED; 
-                    notifyObservers();
+                    publishChange(BoardChange::PAINT_COLOR);
                 }
             }
         } else {  // BLUE robot
@@ -263,7 +377,7 @@ namespace Paintbots{
                 blueRobotHitDuration--;
                 if (blueRobotHitDuration == 0) {
                     blueRobotPaintColor = BLUE; 
-                    notifyObservers();
+                    publishChange(BoardChange::PAINT_COLOR);
                 }
             }
         }
@@ -272,24 +386,15 @@ namespace Paintbots{
         switch(mr.move) {
             case RobotMoveRequest::FORWARD: {
                 // Calculate next position based on direction
-                int nextRow = robotRow;
-                int nextCol = robotCol;
-                
-                switch(robotDir) {
-                    case NORTH: nextRow--; break;
-                    case SOUTH: nextRow++; break;
-                    case EAST: nextCol++; break;
-                    case WEST: nextCol--; break;
-                    default:
-                        throw std::invalid_argument("Invalid robot direction");
-                }
+                int nextRow = robotRow + rowStep(robotDir);
+                int nextCol = robotCol + colStep(robotDir);
 
                 // Check if next square is valid
                 if (!isValidPosition(nextRow, nextCol)) {
                     return false;
                 }
 
-                InternalBoardSquare& nextSquare = board[nextRow][nextCol];
+                InternalBoardSquare& nextSquare = cell(nextRow, nextCol);
 
                 // Check for obstacles
                 if (nextSquare.getSquareType() == WALL || 
@@ -308,8 +413,9 @@ namespace Paintbots{
                 }
 
                 // Paint both the square we're leaving and the square we're moving to
-                currentSquare.setSquareColor(paintColor);
-                nextSquare.setSquareColor(paintColor);
+                ++version; 
+                paintSquare(robotRow, robotCol, paintColor);
+                paintSquare(nextRow, nextCol, paintColor);
                 
                 // Move robot to new square
                 if (mr.robot == RobotMoveRequest::RED) {
@@ -321,42 +427,34 @@ namespace Paintbots{
                 }
                 
                 nextSquare.setRobotDirection(robotDir);
-                notifyObservers();
+                position.row = nextRow; 
+                position.col = nextCol; 
+                publishChange(BoardChange::ROBOT_MOVED);
                 break;
             }
             
             case RobotMoveRequest::ROTATELEFT: {
-                Direction newDir;
-                switch(robotDir) {
-                    case NORTH: newDir = WEST; break;
-                    case WEST: newDir = SOUTH; break;
-                    case SOUTH: newDir = EAST; break;
-                    case EAST: newDir = NORTH; break;
-                    default:
-                        throw std::invalid_argument("Invalid robot direction");
-                }
+                Direction newDir = rotateLeft(robotDir);
+                ++version; 
                 currentSquare.setRobotDirection(newDir);
-                notifyObservers();
+                position.facing = newDir; 
+                markChanged(robotRow, robotCol); 
+                publishChange(BoardChange::ROBOT_TURNED);
                 break;
             }
             
             case RobotMoveRequest::ROTATERIGHT: {
-                Direction newDir;
-                switch(robotDir) {
-                    case NORTH: newDir = EAST; break;
-                    case EAST: newDir = SOUTH; break;
-                    case SOUTH: newDir = WEST; break;
-                    case WEST: newDir = NORTH; break;
-                    default:
-                        throw std::invalid_argument("Invalid robot direction");
-                }
+                Direction newDir = rotateRight(robotDir);
+                ++version; 
                 currentSquare.setRobotDirection(newDir);
-                notifyObservers();
+                position.facing = newDir; 
+                markChanged(robotRow, robotCol); 
+                publishChange(BoardChange::ROBOT_TURNED);
                 break;
             }
             
             case RobotMoveRequest::NONE:
-                notifyObservers();
+                publishChange(BoardChange::ROBOT_IDLE);
                 break;
             
             default:
@@ -366,17 +464,74 @@ namespace Paintbots{
         return true;
     }
 
+    /**
+     * Batches only count, the changes pile up in pending either way 
+     */
+    void GameBoard::beginBatch() {
+        ++batchDepth; 
+    }
+
+    /**
+     * The outermost end delivers what the batch collected 
+     */
+    void GameBoard::endBatch() {
+        if (batchDepth == 0) {
+            throw std::logic_error("endBatch without beginBatch"); 
+        }
+        if (--batchDepth == 0) {
+            flushChanges(); 
+        }
+    }
+
+    /**
+     * A batch that was never opened has nothing to abandon 
+     */
+    void GameBoard::abandonBatch() noexcept {
+        if (batchDepth > 0) {
+            --batchDepth; 
+        }
+    }
+
+    /**
+     * Inside a batch the change only piles up. Without observers nothing is kept, so 
+     * headless matches pay one branch per change 
+     */
+    void GameBoard::publishChange(BoardChange::Kind kind) {
+        if (!hasObservers()) {
+            return; 
+        }
+        pending.add(kind); 
+        if (batchDepth == 0) {
+            flushChanges(); 
+        }
+    }
+
+    /**
+     * Observers may edit the board while being notified, so the change is moved out 
+     * of pending before they see it. Their time counts as NOTIFY 
+     */
+    void GameBoard::flushChanges() {
+        if (pending.empty()) {
+            return; 
+        }
+        std::swap(pending, delivered); 
+        pending.clear(); 
+        PAINTBOTS_PROFILE_SCOPE(Profiler::NOTIFY); 
+        notifyObservers(delivered); 
+    }
+
     /**
      * Determines if a paint blob shot by a robot hits the opponent 
      * 
-     * Traces the trajectory of a paint blob from the shooting robot's position in the direction 
-     * the robot is facing. Also handles: 
+     * Checks the line of fire from the shooting robot's position in the direction the robot is 
+     * facing against the precomputed bitboard rays. Also handles: 
      * - Paint blob limit tracking 
      * - Blocking by walls or rocks 
      * - Hitting opponent robots 
      * - Updating hit duration and paint color 
      */
     bool GameBoard::paintBlobHit(RobotMoveRequest& mr) {
+        PAINTBOTS_PROFILE_SCOPE(Profiler::PAINT_BLOB); 
         if (!mr.shoot) return false;
         
         // Check paint blob limit
@@ -390,125 +545,71 @@ namespace Paintbots{
             }
         }
 
-        // Find current robot position and direction
-        int shooterRow = -1, shooterCol = -1;
-        Direction shooterDir;
-
         if (mr.robot != RobotMoveRequest::RED && mr.robot != RobotMoveRequest::BLUE) {
             throw std::invalid_argument("Invalid robot color for paint blob");
         }
 
-        // Find shooter's position and direction
-        for (int i = 1; i <= BOARD_SIZE; ++i) {
-            for (int j = 1; j <= BOARD_SIZE; ++j) {
-                if ((mr.robot == RobotMoveRequest::RED && board[i][j].redRobotPresent()) || 
-                    (mr.robot == RobotMoveRequest::BLUE && board[i][j].blueRobotPresent())) {
-                    shooterRow = i;
-                    shooterCol = j;
-                    shooterDir = board[i][j].robotDirection();
-                    break;
-                }
-            }
-            if (shooterRow != -1) break;
-        }
-
-        // If shooter not found, throw exception
-        if (shooterRow == -1) {
-            throw std::runtime_error("Robot not found on board");
+        // Look up the shooter's position and direction
+        const RobotPosition& shooter = robotPosition(mr.robot); 
+        int shooterRow = shooter.row; 
+        int shooterCol = shooter.col; 
+        Direction shooterDir = shooter.facing; 
+
+        // The opponent may be missing when a board is set up by hand 
+        const RobotPosition& target = (mr.robot == RobotMoveRequest::RED) ? bluePosition : redPosition; 
+        if (target.row == -1 || 
+            !layers.inLineOfFire(shooterRow, shooterCol, shooterDir, target.row, target.col)) {
+            return false; 
         }
 
-        // Calculate direction offsets
-        int rowOffset = 0, colOffset = 0;
-        switch (shooterDir) {
-            case NORTH: rowOffset = -1; break;
-            case SOUTH: rowOffset = 1; break;
-            case EAST: colOffset = 1; break;
-            case WEST: colOffset = -1; break;
-            default:
-                throw std::invalid_argument("Invalid robot direction");
+        ++version; 
+        if (mr.robot == RobotMoveRequest::RED) {
+            blueRobotHitDuration = config.getHitDuration();
+            blueRobotPaintColor = RED;
+            redPaintBlobsRemaining--;  // Decrement paint blobs only on successful hit
+        } else {
+            redRobotHitDuration = config.getHitDuration();
+            redRobotPaintColor = BLUE;
+            bluePaintBlobsRemaining--;  // Decrement paint blobs only on successful hit
         }
 
-        // Check along the line of fire
-        int currentRow = shooterRow + rowOffset;
-        int currentCol = shooterCol + colOffset;
-
-        while (isValidPosition(currentRow, currentCol)) {
-            InternalBoardSquare& currentSquare = board[currentRow][currentCol];
-
-            if (currentSquare.getSquareType() == WALL || 
-                currentSquare.getSquareType() == ROCK) {
-                return false;
-            }
-
-            // Check for hit on opponent
-            bool hitDetected = false;
-            if (mr.robot == RobotMoveRequest::RED && currentSquare.blueRobotPresent()) {
-                blueRobotHitDuration = config.getHitDuration();
-                blueRobotPaintColor = RED;
-                redPaintBlobsRemaining--;  // Decrement paint blobs only on successful hit
-                hitDetected = true;
-            } else if (mr.robot == RobotMoveRequest::BLUE && currentSquare.redRobotPresent()) {
-                redRobotHitDuration = config.getHitDuration();
-                redRobotPaintColor = BLUE;
-                bluePaintBlobsRemaining--;  // Decrement paint blobs only on successful hit
-                hitDetected = true;
-            }
-
-            if (hitDetected) {
-                notifyObservers();
-                return true;
-            }
-
-            currentRow += rowOffset;
-            currentCol += colOffset;
+        if (hasObservers()) {
+            pending.add(BoardChange::PAINT_COLOR); 
         }
-
-        return false;
+        publishChange(BoardChange::HIT);
+        return true;
     }
 
     /**
      * Method to return the blue robot's score 
      */
-    int GameBoard::blueScore(){
-        int score = 0; 
-        
-        for (int i = 1; i <= BOARD_SIZE; ++i){
-            for (int j = 1; j <= BOARD_SIZE; ++j){
-                if (board[i][j].getSquareColor() == BLUE){
-                    ++score; 
-                }
-            }
+    int GameBoard::blueScore() const {
+        if (squaresStale) {
+            rescanBoard(); 
         }
-
-        notifyObservers(); 
-        return score; 
+        return layers.count(BitBoard::BLUE_LAYER); 
     }
 
     /**
      * Method to return the red robot's score 
      */
-    int GameBoard::redScore() {
-        int score = 0;
-        for (int i = 1; i <= BOARD_SIZE; ++i) {
-            for (int j = 1; j <= BOARD_SIZE; ++j) {
-                SquareColor color = board[i][j].getSquareColor();
-                if (color == RED) {
-                    ++score;
-                }
-            }
+    int GameBoard::redScore() const {
+        if (squaresStale) {
+            rescanBoard(); 
         }
-        return score;
+        return layers.count(BitBoard::RED_LAYER); 
     }
 
     /**
      * Method to set a square on the gameboard to a particular color 
      */
     void GameBoard::setSquareColor(int row, int col, SquareColor color) {
+        ++version; 
         if (!isValidPosition(row, col)) {
             throw std::out_of_range("Invalid board position");
         }
-        board[row][col].setSquareColor(color);
-        notifyObservers();  // Ensure this is being called
+        paintSquare(row, col, color);
+        publishChange(BoardChange::SQUARES);
     }
 
     /**
@@ -524,116 +625,118 @@ namespace Paintbots{
         } else {
             blueRobotPaintColor = color;
         }
-        notifyObservers();
+        publishChange(BoardChange::PAINT_COLOR);
+    }
+
+    /**
+     * Copies a filled n*n scan buffer into a freshly allocated jagged array 
+     */
+    template<class Buffer>
+    static ExternalBoardSquare** allocateScan(const Buffer& buffer, int n) {
+        ExternalBoardSquare** scan = new ExternalBoardSquare*[n];
+        for (int i = 0; i < n; ++i) {
+            scan[i] = new ExternalBoardSquare[n]; 
+            std::copy(buffer[i], buffer[i] + n, scan[i]);
+        }
+        return scan;
     }
 
     /**
      * Gets a view of the entire board 
      */
     ExternalBoardSquare** GameBoard::getLongRangeScan() {
-        ExternalBoardSquare** scan = new ExternalBoardSquare*[BOARD_SIZE + 2];
-        for (int i = 0; i < BOARD_SIZE + 2; ++i) {
-            scan[i] = new ExternalBoardSquare[BOARD_SIZE + 2]; 
-            for (int j = 0; j < BOARD_SIZE + 2; ++j) {
-                scan[i][j] = ExternalBoardSquare(board[i][j]);
+        LongRangeScan buffer; 
+        getLongRangeScan(buffer); 
+        return allocateScan(buffer, buffer.size());
+    }   
+
+    /**
+     * Copies every square, walls included, into the scan 
+     */
+    template<class Geometry>
+    void GameBoard::copySquares(Geometry geometry, LongRangeScan& scan) const {
+        for (int i = 0; i < geometry.stride(); ++i) {
+            const InternalBoardSquare* row = &grid[i * geometry.stride()]; 
+            ExternalBoardSquare* out = scan[i]; 
+            for (int j = 0; j < geometry.stride(); ++j) {
+                out[j] = ExternalBoardSquare(row[j]);
             }
         }
-        return scan;
-    }   
+    }
+
+    /**
+     * Fills the buffer with a view of the entire board, sizing it first 
+     */
+    void GameBoard::getLongRangeScan(LongRangeScan& scan) const {
+        PAINTBOTS_PROFILE_SCOPE(Profiler::LONG_SCAN); 
+        scan.resize(size + 2); 
+        if (size == BOARD_SIZE) {
+            copySquares(FixedGeometry<BOARD_SIZE>(), scan); 
+        } else {
+            copySquares(RuntimeGeometry{size}, scan); 
+        }
+    }
 
     /**
      * Gets a 5*5 view of the board with the robot being in the center and the 
      * direction that is facing is considered up. 
      */
     ExternalBoardSquare** GameBoard::getShortRangeScan(RobotMoveRequest::RobotColor rc) {
-        // Find robot position and direction
-        int robotRow = -1, robotCol = -1;
-        Direction robotDir;
+        ShortRangeScan buffer; 
+        getShortRangeScan(rc, buffer); 
+        return allocateScan(buffer, SHORT_RANGE_SIZE);
+    }
 
+    /**
+     * Fills the buffer with the 5*5 view around a robot, the direction it is 
+     * facing is considered up 
+     */
+    void GameBoard::getShortRangeScan(RobotMoveRequest::RobotColor rc, ShortRangeScan& scan) {
+        PAINTBOTS_PROFILE_SCOPE(Profiler::SHORT_SCAN); 
         if (rc != RobotMoveRequest::RED && rc != RobotMoveRequest::BLUE) {
             throw std::invalid_argument("Invalid robot color for scan");
         }
-        
-        // Find the robot's position and direction
-        for (int i = 1; i <= BOARD_SIZE; ++i) {
-            for (int j = 1; j <= BOARD_SIZE; ++j) {
-                if ((rc == RobotMoveRequest::RED && board[i][j].redRobotPresent()) || 
-                    (rc == RobotMoveRequest::BLUE && board[i][j].blueRobotPresent())) {
-                    robotRow = i;
-                    robotCol = j;
-                    robotDir = board[i][j].robotDirection();
-                    break;
-                }
-            }
-            if (robotRow != -1) break;
-        }
 
-        if (robotRow == -1) {
-            throw std::runtime_error("Robot not found on board");
-        }
-
-        // Create 5x5 scan array
-        ExternalBoardSquare** scan = new ExternalBoardSquare*[5];
-        for (int i = 0; i < 5; ++i) {
-            scan[i] = new ExternalBoardSquare[5];
-        }
+        // Look up the robot's position and direction
+        const RobotPosition& position = robotPosition(rc); 
+        int robotRow = position.row; 
+        int robotCol = position.col; 
+        Direction robotDir = position.facing; 
 
         // If robot is in fog, return all empty squares except center
-        if (board[robotRow][robotCol].getSquareType() == FOG) {
+        if (cell(robotRow, robotCol).getSquareType() == FOG) {
             for (int i = 0; i < 5; ++i) {
                 for (int j = 0; j < 5; ++j) {
                     if (i == 2 && j == 2) {
-                        scan[i][j] = ExternalBoardSquare(board[robotRow][robotCol]);
+                        scan[i][j] = ExternalBoardSquare(cell(robotRow, robotCol));
                     } else {
                         scan[i][j] = ExternalBoardSquare();  // Empty square
                     }
                 }
             }
-            return scan;
+            return;
         }
 
-        // Calculate scan based on robot's direction
+        // Scan rows run from ahead of the robot to behind it, columns from its left 
+        // to its right, so each step down or right is a fixed board offset 
+        const int stride = size + 2; 
+        const Direction down = opposite(robotDir); 
+        const Direction right = rotateRight(robotDir); 
+        const int rowOrigin = robotRow - 2 * (rowStep(down) + rowStep(right)); 
+        const int colOrigin = robotCol - 2 * (colStep(down) + colStep(right)); 
         for (int i = 0; i < 5; ++i) {
+            int boardRow = rowOrigin + i * rowStep(down); 
+            int boardCol = colOrigin + i * colStep(down); 
+            ExternalBoardSquare* out = scan[i]; 
             for (int j = 0; j < 5; ++j) {
-                // Calculate position relative to robot (robot is at center [2][2])
-                int relRow = i - 2;
-                int relCol = j - 2;
-                
-                // Transform coordinates based on robot's direction
-                int boardRow, boardCol;
-                switch(robotDir) {
-                    case NORTH:
-                        boardRow = robotRow + relRow;
-                        boardCol = robotCol + relCol;
-                        break;
-                    case EAST:
-                        boardRow = robotRow + relCol;
-                        boardCol = robotCol - relRow;
-                        break;
-                    case SOUTH:
-                        boardRow = robotRow - relRow;
-                        boardCol = robotCol - relCol;
-                        break;
-                    case WEST:
-                        boardRow = robotRow - relCol;
-                        boardCol = robotCol + relRow;
-                        break;
-                }
-
-                // Check if position is within board bounds
-                if (boardRow >= 0 && boardRow < BOARD_SIZE + 2 && 
-                    boardCol >= 0 && boardCol < BOARD_SIZE + 2) {
-                    scan[i][j] = ExternalBoardSquare(board[boardRow][boardCol]);
-                } else {
-                    // Out of bounds shows as wall
-                    InternalBoardSquare wallSquare;
-                    wallSquare.setType(WALL);
-                    scan[i][j] = ExternalBoardSquare(wallSquare);
-                }
+                // Squares past the outer walls show as walls 
+                bool inside = (unsigned(boardRow) < unsigned(stride)) & (unsigned(boardCol) < unsigned(stride)); 
+                const InternalBoardSquare* source = inside ? grid.data() + (boardRow * stride + boardCol) : &WALL_SENTINEL; 
+                out[j] = ExternalBoardSquare(*source); 
+                boardRow += rowStep(right); 
+                boardCol += colStep(right); 
             }
-    }
-
-        return scan;
+        }
     }
 
     /**
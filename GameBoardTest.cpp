@@ -1,9 +1,15 @@
 // GameBoardTest.cpp
 #include "GameBoardTest.h"
 #include "GameBoard.h"
+#include "BoardView.h"
+#include "ConfigError.h"
+#include "LayoutCorpus.h"
+#include "Directions.h"
 #include <iostream>
 #include <fstream>
+#include <vector>
 #include <cassert>
+#include <cstdio>
 #include <stdexcept>
 #include <cstring> 
 #include <stdexcept>  
@@ -113,6 +119,243 @@ void GameBoardTest::testPasswordProtection() {
     }
 }
 
+/**
+ * @test Boards created directly live side by side and do not share state 
+ */
+void GameBoardTest::testIndependentBoards() {
+    createTestConfig("independent.txt", "PAINTBLOB_LIMIT = 3\n");
+    GameBoard first;
+    GameBoard second((Config("independent.txt")));
+
+    assert(&first != GameBoard::getInstance("xyzzy"));
+    assert(first.getRemainingPaintBlobs(RobotMoveRequest::RED) == Config().getPaintBlobLimit());
+    assert(second.getRemainingPaintBlobs(RobotMoveRequest::RED) == 3);
+    assert(second.getConfig().getPaintBlobLimit() == 3);
+
+    first.getSquare(1, 1).setSquareColor(RED);
+    second.getSquare(1, 1).setSquareColor(BLUE);
+    assert(first.getSquare(1, 1).getSquareColor() == RED);
+    assert(second.getSquare(1, 1).getSquareColor() == BLUE);
+
+    std::remove("independent.txt");
+    std::cout << "Independent boards test: PASS\n";
+}
+
+/**
+ * @test Copies carry the game state but not the observers, and diverge afterwards 
+ */
+void GameBoardTest::testBoardCopy() {
+    GameBoard original;
+    MockObserver observer;
+    original.addObserver(&observer);
+
+    GameBoard copy(original);
+    assert(copy.getObservers().empty());
+    assert(copy.redScore() == original.redScore());
+    for (int i = 0; i < GameBoard::BOARD_SIZE + 2; ++i) {
+        for (int j = 0; j < GameBoard::BOARD_SIZE + 2; ++j) {
+            assert(copy.getSquare(i, j).getSquareType() == original.getSquare(i, j).getSquareType());
+            assert(copy.getSquare(i, j).redRobotPresent() == original.getSquare(i, j).redRobotPresent());
+        }
+    }
+
+    copy.getSquare(1, 1).setSquareColor(BLUE);
+    original.getSquare(1, 1).setSquareColor(RED);
+    assert(copy.getSquare(1, 1).getSquareColor() == BLUE);
+
+    // Assigning a new game keeps the observers of the target
+    original = GameBoard();
+    assert(original.getObservers().size() == 1);
+    assert(original.getSquare(1, 1).getSquareColor() == WHITE);
+
+    original.removeObserver(&observer);
+    std::cout << "Board copy test: PASS\n";
+}
+
+/**
+ * @test Boards built from the same seed share rocks, fog and robots 
+ */
+void GameBoardTest::testSeededLayout() {
+    Config config;
+    config.setSeed(1234);
+    GameBoard first(config);
+    GameBoard second(config);
+    config.setSeed(1235);
+    GameBoard other(config);
+
+    assert(first.getSeed() == 1234);
+    bool differs = false;
+    for (int i = 0; i < GameBoard::BOARD_SIZE + 2; ++i) {
+        for (int j = 0; j < GameBoard::BOARD_SIZE + 2; ++j) {
+            assert(first.getSquare(i, j).getSquareType() == second.getSquare(i, j).getSquareType());
+            assert(first.getSquare(i, j).redRobotPresent() == second.getSquare(i, j).redRobotPresent());
+            assert(first.getSquare(i, j).blueRobotPresent() == second.getSquare(i, j).blueRobotPresent());
+            differs = differs || first.getSquare(i, j).getSquareType() != other.getSquare(i, j).getSquareType();
+        }
+    }
+    assert(differs);
+    std::cout << "Seeded layout test: PASS\n";
+}
+
+/**
+ * @test A board packed to the last free square is generated exactly, and bounds that 
+ * cannot fit are rejected instead of looping forever 
+ */
+void GameBoardTest::testLayoutFeasibility() {
+    {
+        std::ofstream file("dense.txt");
+        file << "ROCK_LOWER_BOUND = 200\nROCK_UPPER_BOUND = 200\n"
+             << "FOG_LOWER_BOUND = 23\nFOG_UPPER_BOUND = 23\n";
+    }
+    Config dense("dense.txt");
+    for (uint64_t seed = 0; seed < 20; ++seed) {
+        dense.setSeed(seed);
+        GameBoard board(dense);
+        int rocks = 0, fog = 0, robots = 0;
+        for (int i = 1; i <= GameBoard::BOARD_SIZE; ++i) {
+            for (int j = 1; j <= GameBoard::BOARD_SIZE; ++j) {
+                const InternalBoardSquare& square = static_cast<const GameBoard&>(board).getSquare(i, j);
+                rocks += square.getSquareType() == ROCK;
+                fog += square.getSquareType() == FOG;
+                if (square.redRobotPresent() || square.blueRobotPresent()) {
+                    assert(square.getSquareType() == EMPTY);
+                    ++robots;
+                }
+            }
+        }
+        assert(rocks == 200 && fog == 23 && robots == 2);
+    }
+
+    {
+        std::ofstream file("overfull.txt");
+        file << "ROCK_LOWER_BOUND = 200\nROCK_UPPER_BOUND = 210\n"
+             << "FOG_LOWER_BOUND = 10\nFOG_UPPER_BOUND = 20\n";
+    }
+    Config overfull("overfull.txt");
+    bool threw = false;
+    try {
+        GameBoard board(overfull);
+    } catch (const ConfigBoundsError&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::remove("dense.txt");
+    std::remove("overfull.txt");
+    std::cout << "Layout feasibility test: PASS\n";
+}
+
+/**
+ * @test Boards of other sizes than the default are walled, scanned and copied at 
+ * their own size, and the bitboard and the view follow them 
+ */
+void GameBoardTest::testBoardSizes() {
+    for (int size : {8, 24}) {
+        Config config;
+        config.setBoardSize(size);
+        config.setSeed(size);
+        GameBoard board(config);
+        const GameBoard& view = board;
+        assert(board.getSize() == size);
+        assert(board.getBitBoard().getSize() == size);
+        for (int i = 0; i < size + 2; ++i) {
+            assert(view.getSquare(0, i).getSquareType() == WALL);
+            assert(view.getSquare(size + 1, i).getSquareType() == WALL);
+            assert(view.getSquare(i, 0).getSquareType() == WALL);
+            assert(view.getSquare(i, size + 1).getSquareType() == WALL);
+        }
+
+        GameBoard::LongRangeScan scan;
+        board.getLongRangeScan(scan);
+        assert(scan.size() == size + 2);
+        GameBoard copy(board);
+        BoardView boardView(copy, scan);
+        assert(boardView.size() == size + 2);
+        int robots = 0;
+        for (int i = 0; i < size + 2; ++i) {
+            for (int j = 0; j < size + 2; ++j) {
+                const InternalBoardSquare& square = view.getSquare(i, j);
+                assert(scan[i][j].getSquareType() == square.getSquareType());
+                assert(boardView.at(i, j).getSquareType() == square.getSquareType());
+                robots += square.redRobotPresent() + square.blueRobotPresent();
+                if (i >= 1 && i <= size && j >= 1 && j <= size) {
+                    assert(board.getBitBoard().test(BitBoard::ROCK_LAYER, i, j) == (square.getSquareType() == ROCK));
+                }
+            }
+        }
+        assert(robots == 2);
+    }
+
+    bool threw = false;
+    try {
+        Config config;
+        config.setBoardSize(0);
+    } catch (const ConfigValueError&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Board sizes test: PASS\n";
+}
+
+/**
+ * @test Boards built from a mapped corpus match the boards it was written from, and 
+ * damaged corpus files are rejected 
+ */
+void GameBoardTest::testLayoutCorpus() {
+    Config config;
+    std::vector<GameBoard> boards;
+    {
+        std::ofstream out("corpus.pblc", std::ios::binary);
+        LayoutCorpus::writeHeader(out, 3);
+        for (uint64_t seed = 40; seed < 43; ++seed) {
+            config.setSeed(seed);
+            boards.push_back(GameBoard(config));
+            LayoutCorpus::writeLayout(out, boards.back());
+        }
+    }
+
+    {
+        LayoutCorpus corpus("corpus.pblc");
+        assert(corpus.size() == 3);
+        for (size_t k = 0; k < corpus.size(); ++k) {
+            GameBoard board(Config(), corpus.at(k));
+            const GameBoard& loaded = board;
+            const GameBoard& original = boards[k];
+            assert(loaded.getSeed() == original.getSeed());
+            for (int i = 0; i < GameBoard::BOARD_SIZE + 2; ++i) {
+                for (int j = 0; j < GameBoard::BOARD_SIZE + 2; ++j) {
+                    assert(loaded.getSquare(i, j).packedState() == original.getSquare(i, j).packedState());
+                }
+            }
+        }
+
+        bool threw = false;
+        try {
+            corpus.at(3);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    {
+        std::ofstream out("corpus.pblc", std::ios::binary);
+        LayoutCorpus::writeHeader(out, 2);
+        LayoutCorpus::writeLayout(out, boards[0]);
+    }
+    bool threw = false;
+    try {
+        LayoutCorpus truncated("corpus.pblc");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::remove("corpus.pblc");
+    std::cout << "Layout corpus test: PASS\n";
+}
+
 /**
  * @test Tests correct board dimentions 
  */
@@ -249,6 +492,7 @@ void GameBoardTest::testBasicRobotMovements() {
     InternalBoardSquare& square = board->getSquare(8, 8);
     square.setRedRobot(true);
     square.setRobotDirection(NORTH);  // Face north so we know there's room to move
+    board->getSquare(7, 8).setType(EMPTY);  // a random rock could block the way
     
     RobotMoveRequest request;
     request.robot = RobotMoveRequest::RED;
@@ -826,6 +1070,7 @@ void GameBoardTest::testScoreIncrementOnMovement() {
     // Place a red robot
     board->getSquare(8, 8).setRedRobot(true);
     board->getSquare(8, 8).setRobotDirection(NORTH);
+    board->getSquare(7, 8).setType(EMPTY);  // a random rock could block the way
     
     // Initial score
     int initialRedScore = board->redScore();
@@ -1080,6 +1325,77 @@ void GameBoardTest::testShortRangeScanDirections() {
     std::cout << "Short Range Scan Directions Test: PASS\n";
 }
 
+/**
+ * @test The direction tables agree with each other, and the short range scan built 
+ * from them matches rotating every square by hand, walls past the edge included 
+ */
+void GameBoardTest::testShortRangeScanRotation() {
+    Direction directions[] = {NORTH, EAST, SOUTH, WEST};
+    for (int k = 0; k < 4; ++k) {
+        Direction dir = directions[k];
+        assert(rotateRight(dir) == directions[(k + 1) % 4]);
+        assert(rotateLeft(rotateRight(dir)) == dir);
+        assert(opposite(opposite(dir)) == dir);
+        assert(rowStep(dir) == -rowStep(opposite(dir)) && colStep(dir) == -colStep(opposite(dir)));
+        for (int turns = 0; turns < 4; ++turns) {
+            assert(turnsRight(dir, directions[(k + turns) % 4]) == turns);
+        }
+    }
+
+    Config config;
+    config.setSeed(12);
+    GameBoard board(config);
+    const GameBoard& view = board;
+    for (int i = 1; i <= GameBoard::BOARD_SIZE; ++i) {
+        for (int j = 1; j <= GameBoard::BOARD_SIZE; ++j) {
+            board.getSquare(i, j).setRedRobot(false);
+            if (view.getSquare(i, j).getSquareType() == FOG) {
+                board.getSquare(i, j).setType(EMPTY);
+            }
+        }
+    }
+
+    int positions[][2] = {{1, 1}, {1, 15}, {8, 8}, {15, 2}, {14, 15}};
+    GameBoard::ShortRangeScan scan;
+    for (auto& position : positions) {
+        int row = position[0], col = position[1];
+        board.getSquare(row, col).setType(EMPTY);
+        board.getSquare(row, col).setRedRobot(true);
+        for (Direction dir : directions) {
+            board.getSquare(row, col).setRobotDirection(dir);
+            board.getShortRangeScan(RobotMoveRequest::RED, scan);
+            for (int i = 0; i < 5; ++i) {
+                for (int j = 0; j < 5; ++j) {
+                    int relRow = i - 2, relCol = j - 2;
+                    int boardRow = row + relRow, boardCol = col + relCol;
+                    if (dir == EAST) {
+                        boardRow = row + relCol;
+                        boardCol = col - relRow;
+                    } else if (dir == SOUTH) {
+                        boardRow = row - relRow;
+                        boardCol = col - relCol;
+                    } else if (dir == WEST) {
+                        boardRow = row - relCol;
+                        boardCol = col + relRow;
+                    }
+                    if (isValidPosition(boardRow, boardCol)) {
+                        const InternalBoardSquare& square = view.getSquare(boardRow, boardCol);
+                        assert(scan[i][j].getSquareType() == square.getSquareType());
+                        assert(scan[i][j].getSquareColor() == square.getSquareColor());
+                        assert(scan[i][j].redRobotPresent() == square.redRobotPresent());
+                        assert(scan[i][j].blueRobotPresent() == square.blueRobotPresent());
+                    } else {
+                        assert(scan[i][j].getSquareType() == WALL);
+                    }
+                }
+            }
+        }
+        board.getSquare(row, col).setRedRobot(false);
+    }
+
+    std::cout << "Short Range Scan Rotation Test: PASS\n";
+}
+
 /**
  * @test Testing short scan behavior to see whether walls show up 
  */
@@ -1465,8 +1781,13 @@ void GameBoardTest::testScoreChangeNotification() {
     MockObserver observer;
     board->addObserver(&observer);
     
+    // Score queries are side effect free, only actual changes notify
     int initialCount = observer.updateCount;
-    board->redScore();  // This should trigger notification
+    board->redScore();
+    board->blueScore();
+    assert(observer.updateCount == initialCount);
+
+    board->setSquareColor(1, 1, BLUE);
     assert(observer.updateCount > initialCount);
     
     board->removeObserver(&observer);
@@ -1552,6 +1873,116 @@ void GameBoardTest::testMultipleObservers() {
     std::cout << "Multiple observers test: PASS\n";
 }
 
+/**
+ * @test Changes name the squares and kinds that changed, and a batch reaches the 
+ * observers as one change holding everything done inside it 
+ */
+void GameBoardTest::testChangeEvents() {
+    Config config;
+    config.setSeed(21);
+    GameBoard board(config);
+    RecordingObserver observer;
+    board.addObserver(&observer);
+
+    board.setSquareColor(3, 4, RED);
+    assert(observer.changes.size() == 1);
+    BoardChange painted = observer.changes.back();
+    assert(painted.has(BoardChange::SQUARES) && !painted.has(BoardChange::ROBOT_MOVED));
+    int dirty = 0;
+    painted.forEachDirty([&](int row, int col) {
+        assert(row == 3 && col == 4);
+        ++dirty;
+    });
+    assert(dirty == 1);
+    assert(painted.isDirty(3, 4) && !painted.isDirty(4, 3));
+
+    RobotMoveRequest turn = {RobotMoveRequest::RED, RobotMoveRequest::ROTATELEFT, false};
+    RobotMoveRequest idle = {RobotMoveRequest::BLUE, RobotMoveRequest::NONE, false};
+    board.beginBatch();
+    board.beginBatch();
+    board.moveRobot(turn);
+    board.endBatch();
+    board.setSquareColor(5, 5, BLUE);
+    board.moveRobot(idle);
+    assert(observer.changes.size() == 1);
+    board.endBatch();
+    assert(observer.changes.size() == 2);
+    const BoardChange& batch = observer.changes.back();
+    assert(batch.has(BoardChange::ROBOT_TURNED) && batch.has(BoardChange::ROBOT_IDLE));
+    assert(batch.has(BoardChange::SQUARES) && batch.isDirty(5, 5) && !batch.isDirty(3, 4));
+    dirty = 0;
+    batch.forEachDirty([&](int row, int col) {
+        const InternalBoardSquare& square = static_cast<const GameBoard&>(board).getSquare(row, col);
+        assert(square.redRobotPresent() || (row == 5 && col == 5));
+        ++dirty;
+    });
+    assert(dirty == 2);
+
+    BoardChange merged(GameBoard::BOARD_SIZE + 2);
+    merged.merge(observer.changes[0]);
+    merged.merge(batch);
+    assert(merged.isDirty(3, 4) && merged.isDirty(5, 5));
+    assert(merged.getKinds() == (painted.getKinds() | batch.getKinds()));
+
+    bool threw = false;
+    try {
+        board.endBatch();
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    board.removeObserver(&observer);
+    std::cout << "Change events test: PASS\n";
+}
+
+/**
+ * @test A committed turn notifies once, a dropped one closes its batch and leaves its 
+ * changes for the next notification, and boards without observers record nothing 
+ */
+void GameBoardTest::testTurnCommit() {
+    Config config;
+    config.setSeed(22);
+    GameBoard board(config);
+    board.setSquareColor(2, 2, RED);
+
+    RecordingObserver observer;
+    board.addObserver(&observer);
+    {
+        GameBoard::Turn turn(board);
+        board.setSquareColor(3, 3, RED);
+        board.setSquareColor(4, 4, BLUE);
+        assert(observer.changes.empty());
+        turn.commit();
+        assert(observer.changes.size() == 1);
+        turn.commit();
+    }
+    assert(observer.changes.size() == 1);
+    assert(observer.changes[0].isDirty(3, 3) && observer.changes[0].isDirty(4, 4));
+    assert(!observer.changes[0].isDirty(2, 2));
+
+    try {
+        GameBoard::Turn turn(board);
+        board.setSquareColor(5, 5, RED);
+        throw std::runtime_error("turn abandoned");
+    } catch (const std::runtime_error&) {
+    }
+    assert(observer.changes.size() == 1);
+    board.setSquareColor(6, 6, BLUE);
+    assert(observer.changes.size() == 2);
+    assert(observer.changes[1].isDirty(5, 5) && observer.changes[1].isDirty(6, 6));
+
+    board.removeObserver(&observer);
+    board.setSquareColor(7, 7, RED);
+    board.addObserver(&observer);
+    board.setSquareColor(8, 8, RED);
+    assert(observer.changes.size() == 3);
+    assert(!observer.changes[2].isDirty(7, 7) && observer.changes[2].isDirty(8, 8));
+
+    board.removeObserver(&observer);
+    std::cout << "Turn commit test: PASS\n";
+}
+
 /**
  * @test Testing square access 
  */
@@ -2184,6 +2615,309 @@ void GameBoardTest::testPaintBlobLimit() {
 
 
 
+/**
+ * @test Moves keep working from the cached robot positions, including after the 
+ * squares were rearranged by hand 
+ */
+void GameBoardTest::testRobotPositionTracking() {
+    GameBoard board;
+    for (int i = 1; i <= GameBoard::BOARD_SIZE; ++i) {
+        for (int j = 1; j <= GameBoard::BOARD_SIZE; ++j) {
+            board.getSquare(i, j) = InternalBoardSquare();
+        }
+    }
+    board.getSquare(8, 8).setRedRobot(true);
+    board.getSquare(8, 8).setRobotDirection(EAST);
+    board.getSquare(2, 2).setBlueRobot(true);
+
+    RobotMoveRequest forward = {RobotMoveRequest::RED, RobotMoveRequest::FORWARD, false};
+    RobotMoveRequest turnLeft = {RobotMoveRequest::RED, RobotMoveRequest::ROTATELEFT, false};
+    assert(board.moveRobot(forward));
+    assert(board.moveRobot(turnLeft));
+    assert(board.moveRobot(forward));
+
+    const GameBoard& view = board;
+    assert(view.getSquare(7, 9).redRobotPresent());
+    assert(view.getSquare(7, 9).robotDirection() == NORTH);
+    assert(!view.getSquare(8, 9).redRobotPresent());
+
+    // Hand placed robots are picked up again
+    board.getSquare(7, 9).setRedRobot(false);
+    board.getSquare(12, 3).setRedRobot(true);
+    board.getSquare(12, 3).setRobotDirection(SOUTH);
+    assert(board.moveRobot(forward));
+    assert(view.getSquare(13, 3).redRobotPresent());
+
+    board.getSquare(13, 3).setRedRobot(false);
+    try {
+        board.moveRobot(forward);
+        assert(false && "Should throw when the robot is not on the board");
+    } catch (const std::runtime_error&) {
+    }
+
+    std::cout << "Robot position tracking test: PASS\n";
+}
+
+/**
+ * @test Robots never end up sharing a square, neither by moving nor by hand 
+ */
+void GameBoardTest::testRobotsCollided() {
+    GameBoard board;
+    assert(!board.robotsCollided());
+
+    for (int i = 1; i <= GameBoard::BOARD_SIZE; ++i) {
+        for (int j = 1; j <= GameBoard::BOARD_SIZE; ++j) {
+            board.getSquare(i, j) = InternalBoardSquare();
+        }
+    }
+    board.getSquare(5, 5).setRedRobot(true);
+    board.getSquare(5, 6).setBlueRobot(true);
+    board.getSquare(5, 6).setRobotDirection(WEST);
+    assert(!board.robotsCollided());
+
+    RobotMoveRequest ram = {RobotMoveRequest::BLUE, RobotMoveRequest::FORWARD, false};
+    assert(!board.moveRobot(ram));
+    assert(!board.robotsCollided());
+
+    try {
+        board.getSquare(5, 5).setBlueRobot(true);
+        assert(false && "Should not place both robots on one square");
+    } catch (const std::runtime_error&) {
+    }
+    assert(!board.robotsCollided());
+
+    std::cout << "Robots collided test: PASS\n";
+}
+
+/**
+ * @test The running score counters agree with a recount of the board after 
+ * moves, direct color changes and hand edits 
+ */
+void GameBoardTest::testScoreMatchesBoardColors() {
+    GameBoard board;
+    const GameBoard& view = board;
+    RobotMoveRequest::RobotMove moves[] = {RobotMoveRequest::FORWARD, RobotMoveRequest::FORWARD,
+                                           RobotMoveRequest::ROTATERIGHT, RobotMoveRequest::FORWARD};
+
+    for (int turn = 0; turn < 40; ++turn) {
+        RobotMoveRequest red = {RobotMoveRequest::RED, moves[turn % 4], false};
+        RobotMoveRequest blue = {RobotMoveRequest::BLUE, moves[(turn + 1) % 4], false};
+        board.moveRobot(red);
+        board.moveRobot(blue);
+        if (turn == 10) {
+            board.setSquareColor(3, 3, BLUE);
+            board.setSquareColor(0, 3, RED);  // walls do not count
+        }
+        if (turn == 20) {
+            board.getSquare(4, 4).setSquareColor(RED);
+        }
+
+        int redCount = 0, blueCount = 0;
+        for (int i = 1; i <= GameBoard::BOARD_SIZE; ++i) {
+            for (int j = 1; j <= GameBoard::BOARD_SIZE; ++j) {
+                if (view.getSquare(i, j).getSquareColor() == RED) ++redCount;
+                if (view.getSquare(i, j).getSquareColor() == BLUE) ++blueCount;
+            }
+        }
+        assert(board.redScore() == redCount);
+        assert(board.blueScore() == blueCount);
+    }
+
+    std::cout << "Score matches board colors test: PASS\n";
+}
+
+/**
+ * Compares two squares field by field 
+ */
+static bool sameSquare(const BoardSquare& a, const BoardSquare& b) {
+    return a.getSquareColor() == b.getSquareColor() &&
+           a.getSquareType() == b.getSquareType() &&
+           a.redRobotPresent() == b.redRobotPresent() &&
+           a.blueRobotPresent() == b.blueRobotPresent() &&
+           a.robotDirection() == b.robotDirection();
+}
+
+/**
+ * @test Filled scan buffers hold the same view as the allocated scans and can be 
+ * handed out as jagged arrays 
+ */
+void GameBoardTest::testScanBuffers() {
+    GameBoard board;
+    RobotMoveRequest turn = {RobotMoveRequest::BLUE, RobotMoveRequest::ROTATERIGHT, false};
+    board.moveRobot(turn);
+
+    GameBoard::LongRangeScan lrs;
+    board.getLongRangeScan(lrs);
+    ExternalBoardSquare** legacyLrs = board.getLongRangeScan();
+    ExternalBoardSquare** lrsView = lrs;
+    for (int i = 0; i < GameBoard::BOARD_SIZE + 2; ++i) {
+        for (int j = 0; j < GameBoard::BOARD_SIZE + 2; ++j) {
+            assert(sameSquare(lrs[i][j], legacyLrs[i][j]));
+            assert(&lrsView[i][j] == &lrs[i][j]);
+        }
+        delete[] legacyLrs[i];
+    }
+    delete[] legacyLrs;
+
+    RobotMoveRequest::RobotColor colors[] = {RobotMoveRequest::RED, RobotMoveRequest::BLUE};
+    for (RobotMoveRequest::RobotColor color : colors) {
+        GameBoard::ShortRangeScan srs;
+        board.getShortRangeScan(color, srs);
+        ExternalBoardSquare** legacySrs = board.getShortRangeScan(color);
+        for (int i = 0; i < GameBoard::SHORT_RANGE_SIZE; ++i) {
+            for (int j = 0; j < GameBoard::SHORT_RANGE_SIZE; ++j) {
+                assert(sameSquare(srs[i][j], legacySrs[i][j]));
+            }
+            delete[] legacySrs[i];
+        }
+        delete[] legacySrs;
+    }
+
+    // Copies own their squares
+    GameBoard::LongRangeScan copy(lrs);
+    ExternalBoardSquare** copyView = copy;
+    assert(&copyView[0][0] != &lrsView[0][0]);
+    assert(sameSquare(copyView[0][0], lrs[0][0]));
+
+    std::cout << "Scan buffer test: PASS\n";
+}
+
+/**
+ * @test The board view reads squares without copying the board, matches the long
+ * range scan once materialized and refuses reads after the board changed 
+ */
+void GameBoardTest::testBoardView() {
+    GameBoard board;
+    GameBoard::LongRangeScan expected;
+    board.getLongRangeScan(expected);
+
+    GameBoard::LongRangeScan buffer;
+    BoardView view(board, buffer);
+    assert(view.size() == GameBoard::BOARD_SIZE + 2);
+    for (int i = 0; i < view.size(); ++i) {
+        for (int j = 0; j < view.size(); ++j) {
+            ExternalBoardSquare square = view.at(i, j);
+            assert(sameSquare(square, expected[i][j]));
+        }
+    }
+    assert(!view.isMaterialized());
+
+    ExternalBoardSquare** rows = view.rows();
+    assert(view.isMaterialized());
+    for (int i = 0; i < view.size(); ++i) {
+        for (int j = 0; j < view.size(); ++j) {
+            assert(sameSquare(rows[i][j], expected[i][j]));
+        }
+    }
+
+    bool threw = false;
+    try {
+        view.at(view.size(), 0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Moves that change no square leave the view readable
+    uint64_t version = board.getVersion();
+    RobotMoveRequest idle = {RobotMoveRequest::RED, RobotMoveRequest::NONE, false};
+    board.paintBlobHit(idle);
+    board.moveRobot(idle);
+    assert(board.getVersion() == version);
+    view.at(1, 1);
+
+    RobotMoveRequest turn = {RobotMoveRequest::RED, RobotMoveRequest::ROTATELEFT, false};
+    board.moveRobot(turn);
+    threw = false;
+    try {
+        view.at(1, 1);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "Board view test: PASS\n";
+}
+
+/**
+ * @test The bitboard layers agree with the squares, also after hand edits 
+ */
+void GameBoardTest::testBitBoardLayers() {
+    GameBoard board;
+    board.getSquare(2, 2).setType(EMPTY);
+    board.getSquare(2, 2).setType(WALL);
+    board.setSquareColor(3, 3, BLUE);
+
+    const GameBoard& view = board;
+    const BitBoard& layers = board.getBitBoard();
+    for (int i = 1; i <= GameBoard::BOARD_SIZE; ++i) {
+        for (int j = 1; j <= GameBoard::BOARD_SIZE; ++j) {
+            const InternalBoardSquare& square = view.getSquare(i, j);
+            assert(layers.test(BitBoard::RED_LAYER, i, j) == (square.getSquareColor() == RED));
+            assert(layers.test(BitBoard::BLUE_LAYER, i, j) == (square.getSquareColor() == BLUE));
+            assert(layers.test(BitBoard::ROCK_LAYER, i, j) == (square.getSquareType() == ROCK));
+            assert(layers.test(BitBoard::FOG_LAYER, i, j) == (square.getSquareType() == FOG));
+            assert(layers.test(BitBoard::WALL_LAYER, i, j) == (square.getSquareType() == WALL));
+        }
+    }
+    assert(!layers.test(BitBoard::WALL_LAYER, 0, 0));
+    assert(layers.count(BitBoard::BLUE_LAYER) == board.blueScore());
+    assert(BitBoard::popcount(0xF0F0ULL) == 8);
+
+    std::cout << "Bitboard layers test: PASS\n";
+}
+
+/**
+ * @test The line of fire of the bitboard gives the same answer as walking it square 
+ * by square, for every pair of squares and direction. Boards of the default size use 
+ * the precomputed rays, other sizes walk the layers 
+ */
+void GameBoardTest::testLineOfFireMasks() {
+    for (int size : {BitBoard::DEFAULT_SIZE, 20}) {
+    BitBoard layers(size);
+    int blockers[][2] = {{3, 3}, {3, 9}, {8, 8}, {12, 4}, {15, 15}, {1, 7}};
+    for (auto& blocker : blockers) {
+        layers.set(BitBoard::ROCK_LAYER, blocker[0], blocker[1], true);
+    }
+    layers.set(BitBoard::WALL_LAYER, 6, 12, true);
+
+    int rowStep[] = {-1, 1, 0, 0};
+    int colStep[] = {0, 0, 1, -1};
+    Direction directions[] = {NORTH, SOUTH, EAST, WEST};
+    int hits = 0;
+
+    for (int d = 0; d < 4; ++d) {
+        for (int fromRow = 1; fromRow <= size; ++fromRow) {
+            for (int fromCol = 1; fromCol <= size; ++fromCol) {
+                for (int toRow = 1; toRow <= size; ++toRow) {
+                    for (int toCol = 1; toCol <= size; ++toCol) {
+                        bool expected = false;
+                        int row = fromRow + rowStep[d], col = fromCol + colStep[d];
+                        while (row >= 1 && row <= size && col >= 1 && col <= size) {
+                            if (row == toRow && col == toCol) {
+                                expected = true;
+                                break;
+                            }
+                            if (layers.test(BitBoard::ROCK_LAYER, row, col) ||
+                                layers.test(BitBoard::WALL_LAYER, row, col)) {
+                                break;
+                            }
+                            row += rowStep[d];
+                            col += colStep[d];
+                        }
+                        assert(layers.inLineOfFire(fromRow, fromCol, directions[d], toRow, toCol) == expected);
+                        hits += expected;
+                    }
+                }
+            }
+        }
+    }
+    assert(hits > 0);
+    }
+
+    std::cout << "Line of fire mask test: PASS\n";
+}
+
 bool GameBoardTest::doTests() {
     bool allTestsPassed = true;
     try {
@@ -2197,6 +2931,12 @@ bool GameBoardTest::doTests() {
         testGetInstanceWithWrongPassword();
         testSingletonBehavior();
         testPasswordProtection();
+        testIndependentBoards();
+        testBoardCopy();
+        testSeededLayout();
+        testLayoutFeasibility();
+        testBoardSizes();
+        testLayoutCorpus();
         tearDown(); 
 
         // 2. Testing for correct board initialization 
@@ -2218,6 +2958,8 @@ bool GameBoardTest::doTests() {
         testBoardBoundaryPrevention();
         testColorTrails();
         testRobotCollisionPrevention();
+        testRobotPositionTracking();
+        testRobotsCollided();
         tearDown(); 
 
         // 4. Paint Blob Tests
@@ -2237,6 +2979,9 @@ bool GameBoardTest::doTests() {
         testScoreIncrementOnMovement();
         testScoreUpdateOnPaintBlob();
         testScoreAfterMultipleOperations();
+        testScoreMatchesBoardColors();
+        testBitBoardLayers();
+        testLineOfFireMasks();
         tearDown(); 
 
         // 6. Short Range Scan Tests
@@ -2244,6 +2989,7 @@ bool GameBoardTest::doTests() {
         testShortRangeScanBasic();
         testShortRangeScanRobotPosition();
         testShortRangeScanDirections();
+        testShortRangeScanRotation();
         testShortRangeScanWallBoundaries();
         testShortRangeScanFogBehavior();
         testShortRangeScanObstructions();
@@ -2257,6 +3003,8 @@ bool GameBoardTest::doTests() {
         testLongRangeFog();
         testLongRangeRobots();
         testLongRangeColors();
+        testScanBuffers();
+        testBoardView();
         tearDown();
 
         // 8. Test observer pattern tests
@@ -2266,6 +3014,8 @@ bool GameBoardTest::doTests() {
         testScoreChangeNotification();
         testObserverManagement();
         testMultipleObservers();
+        testChangeEvents();
+        testTurnCommit();
         tearDown();
 
         // Error handling tests
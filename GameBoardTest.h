@@ -115,6 +115,12 @@ namespace Paintbots {
             void testGetInstanceWithWrongPassword();
             void testSingletonBehavior();
             void testPasswordProtection();
+            void testIndependentBoards();
+            void testBoardCopy();
+            void testSeededLayout();
+            void testLayoutFeasibility();
+            void testBoardSizes();
+            void testLayoutCorpus();
 
             // 2. Testing for correct board initialization 
             void testBoardDimensions();
@@ -132,6 +138,8 @@ namespace Paintbots {
             void testBoardBoundaryPrevention();
             void testColorTrails();
             void testRobotCollisionPrevention();
+            void testRobotPositionTracking();
+            void testRobotsCollided();
 
             // 4. testing paintblob 
             void testPaintBlobHit();
@@ -147,11 +155,15 @@ namespace Paintbots {
             void testScoreIncrementOnMovement();
             void testScoreUpdateOnPaintBlob();
             void testScoreAfterMultipleOperations();
+            void testScoreMatchesBoardColors();
+            void testBitBoardLayers();
+            void testLineOfFireMasks();
             
             // 6. Tests for short range scans 
             void testShortRangeScanBasic();
             void testShortRangeScanRobotPosition();
             void testShortRangeScanDirections();
+            void testShortRangeScanRotation();
             void testShortRangeScanWallBoundaries();
             void testShortRangeScanFogBehavior();
             void testShortRangeScanObstructions();
@@ -163,6 +175,8 @@ namespace Paintbots {
             void testLongRangeFog();
             void testLongRangeRobots();
             void testLongRangeColors();
+            void testScanBuffers();
+            void testBoardView();
 
             // 8. Observer pattern tests
             void testMovementNotification();
@@ -170,6 +184,8 @@ namespace Paintbots {
             void testScoreChangeNotification();
             void testObserverManagement();
             void testMultipleObservers();
+            void testChangeEvents();
+            void testTurnCommit();
 
             // 9. Error handling tests
             void testInvalidSquareAccess();
@@ -201,6 +217,14 @@ namespace Paintbots {
                     void update(Observable* subject) override { updateCount++; }
                     ~MockObserver() override = default; 
             };
+
+            // Observer keeping the changes it was told about 
+            class RecordingObserver : public Observer {
+                public:
+                    std::vector<BoardChange> changes;
+                    void update(Observable* subject) override {(void)subject;}
+                    void update(Observable* subject, const BoardChange& change) override { (void)subject; changes.push_back(change); }
+            };
         
         public:
             bool doTests() override;
@@ -3,6 +3,9 @@
 #include "LazyRobot.h"     
 #include "AntiRandom.h"
 #include "RandomRobot.h"   
+#include "Replay.h"
+#include "Profiler.h"
+#include "MatchSeed.h"
 #include <stdexcept>
 #include <memory>
 #include <cstring>
@@ -16,41 +19,26 @@ namespace Paintbots {
      * Constructor for creating the board 
      */
     GameLogic::GameLogic() : 
-        config(Config::getInstance()),
-        board(GameBoard::getInstance("xyzzy")),
+        board(),
         redRobot(),
         blueRobot(),
-        pauseMode(true) 
+        pauseMode(true),
+        quiet(false),
+        ansi(false),
+        displayEvery(1),
+        games(1),
+        seedOverride(false),
+        seed(0),
+        concurrentAgents(false) 
     {
-        std::cout << "Starting GameLogic initialization..." << std::endl;
-        board->addObserver(&display);
+        board.addObserver(&display);
         
         // Initialize roster with robots
         RobotAgentRoster& roster = RobotAgentRoster::getInstance();
-        std::cout << "Initial roster size: " << roster.size() << std::endl;
-        
         try {
-            // Create and add robots to roster
-            LazyRobot* lazyRobot = new LazyRobot();
-            RandomRobot* randomRobot = new RandomRobot();
-            AntiRandom* antiRandom = new AntiRandom();  // Add this line
-            
-            std::cout << "Created robot instances" << std::endl;
-            
-            roster.add(lazyRobot);
-            roster.add(randomRobot);
-            roster.add(antiRandom);  // Add this line
-            
-            std::cout << "Added robots to roster. New size: " << roster.size() << std::endl;
-
-            // Debug check
-            try {
-                IRobotAgent* test = roster["LazyRobot"];
-                std::cout << "Successfully retrieved LazyRobot from roster" << std::endl;
-            } catch (const std::exception& e) {
-                std::cout << "Failed to retrieve LazyRobot: " << e.what() << std::endl;
-            }
-            
+            roster.registerAgent<LazyRobot>();
+            roster.registerAgent<RandomRobot>();
+            roster.registerAgent<AntiRandom>();
         } catch (const std::exception& e) {
             std::cerr << "Failed to initialize robots: " << e.what() << std::endl;
             throw;
@@ -61,8 +49,6 @@ namespace Paintbots {
      * Loads the different robot strategies - lazy, random or antirandom 
      */
     void GameLogic::loadRobotStrategies(const std::string& robotConfigFile) {
-        std::cout << "Loading robot strategies from: " << robotConfigFile << std::endl;
-        
         std::ifstream configFile(robotConfigFile);
         if (!configFile.is_open()) {
             throw std::runtime_error("Could not open robot configuration file: " + robotConfigFile);
@@ -77,16 +63,8 @@ namespace Paintbots {
         blueRobotName.erase(0, blueRobotName.find_first_not_of(" \t\n\r"));
         blueRobotName.erase(blueRobotName.find_last_not_of(" \t\n\r") + 1);
 
-        std::cout << "Looking for robots: Red='" << redRobotName << "', Blue='" << blueRobotName << "'" << std::endl;
-        
         RobotAgentRoster& roster = RobotAgentRoster::getInstance();
-        std::cout << "Current roster size: " << roster.size() << std::endl;
-
         try {
-            for (size_t i = 0; i < roster.size(); ++i) {
-                std::cout << "Robot " << i << ": " << roster[i]->getRobotName() << std::endl;
-            }
-            
             // Set red robot
             IRobotAgent* redStrategy = roster[redRobotName];
             redRobot.setRobotAgent(redStrategy);
@@ -102,81 +80,76 @@ namespace Paintbots {
     }
 
     /**
-     * Pauses execution of game, which may continue when the user hits enter 
+     * Only one display watches the board, so a quiet game tracks no changes at all 
      */
-    void GameLogic::checkPause() {
-        if (pauseMode) {
-            std::cout << "Press Enter to continue...";
-            std::cin.get();
+    void GameLogic::attachDisplay() {
+        board.removeObserver(&display);
+        board.removeObserver(&ansiDisplay);
+        if (!quiet) {
+            board.addObserver(ansi ? static_cast<Observer*>(&ansiDisplay) : &display);
         }
     }
 
     /**
-     * Processes the different robot moves 
+     * A new game reloads the whole board, the ANSI display also clears the screen 
      */
-    bool GameLogic::processRobotMoves(RobotMoveRequest* redMove, RobotMoveRequest* blueMove) {
-        if (!redMove || !blueMove) {
-            throw std::runtime_error("Invalid move requests");
-        }
-
-        // Process paint blob hits first
-        bool redHit = board->paintBlobHit(*redMove);
-        bool blueHit = board->paintBlobHit(*blueMove);
-
-        if (redHit) {
-            std::cout << "Red robot's paint blob hit the blue robot!" << std::endl;
-        }
-        if (blueHit) {
-            std::cout << "Blue robot's paint blob hit the red robot!" << std::endl;
-        }
-
-        // Perform moves
-        bool redMoveResult = board->moveRobot(*redMove);
-        bool blueMoveResult = board->moveRobot(*blueMove);
-
-        // Check for invalid moves or collisions
-        if (!redMoveResult || !blueMoveResult) {
-            std::cout << "Game ended due to invalid move.\n";
-            return false;
+    void GameLogic::showBoard(bool newGame) {
+        PAINTBOTS_PROFILE_SCOPE(Profiler::DISPLAY);
+        if (ansi) {
+            if (newGame) {
+                ansiDisplay.invalidate();
+                ansiDisplay.update(&board);
+            }
+            ansiDisplay.display();
+        } else {
+            if (newGame) {
+                display.update(&board);
+            }
+            display.display();
         }
-
-        return !checkGameEnd();
     }
 
     /**
-     * Method to clean up scan contents 
+     * Pauses execution of game, which may continue when the user hits enter 
      */
-    void GameLogic::cleanupScan(ExternalBoardSquare** scan, int size) {
-        if (scan) {
-            for (int i = 0; i < size; ++i) {
-                delete[] scan[i];
-            }
-            delete[] scan;
+    void GameLogic::checkPause() {
+        if (pauseMode) {
+            std::cout << "Press Enter to continue...";
+            std::cin.get();
         }
     }
 
     /**
-     * Method to check for game ending conditions 
+     * Prints paint blob hits and why the game ended, if it did 
      */
-    bool GameLogic::checkGameEnd() const {
-        for (int i = 1; i <= GameBoard::BOARD_SIZE; ++i) {
-            for (int j = 1; j <= GameBoard::BOARD_SIZE; ++j) {
-                if (board->getSquare(i, j).redRobotPresent() && 
-                    board->getSquare(i, j).blueRobotPresent()) {
+    void GameLogic::reportTurn(const Match& match) const {
+        if (match.redHitLastTurn()) {
+            std::cout << "Red robot's paint blob hit the blue robot!" << std::endl;
+        }
+        if (match.blueHitLastTurn()) {
+            std::cout << "Blue robot's paint blob hit the red robot!" << std::endl;
+        }
+
+        if (match.isOver()) {
+            switch (match.getEndReason()) {
+                case MatchResult::INVALID_MOVE:
+                    std::cout << "Game ended due to invalid move.\n";
+                    break;
+                case MatchResult::COLLISION:
                     std::cout << "Robots collided!\n";
-                    return true;
-                }
+                    break;
+                default:
+                    break;
             }
         }
-        return false;
     }
 
     /**
      * Method to print out results of the game 
      */
     void GameLogic::announceResults() const {
-        int redScore = board->redScore();
-        int blueScore = board->blueScore();
+        int redScore = board.redScore();
+        int blueScore = board.blueScore();
 
         std::cout << "\nGame Over!\n";
         std::cout << "Red Score: " << redScore << "\n";
@@ -194,51 +167,129 @@ namespace Paintbots {
     }
 
     /**
-     * Executes game 
+     * Plays one game on the board, showing it every displayEvery turns unless quiet. 
+     * The agents are spawned afresh, so nothing carries over from an earlier game and 
+     * the printed seed replays the game on its own 
      */
-    void GameLogic::playGame(const std::string& boardConfig, const std::string& robotConfig) {
-        try {
-            // Load configurations
-            Config::getInstance(boardConfig);
-            loadRobotStrategies(robotConfig);
+    MatchResult GameLogic::playMatch(const Config& boardSettings) {
+        board = GameBoard(boardSettings);
+        if (!quiet) {
+            std::cout << "Match seed: " << board.getSeed() << std::endl;
 
             // Initial board display
-            display.display();
+            showBoard(true);
             checkPause();
+        }
 
-            // Main game loop 
-            for (int moveCount = 0; moveCount < MAX_MOVES; ++moveCount) {
-                // Get scans for both robots
-                std::unique_ptr<ExternalBoardSquare*[]> redSrs(board->getShortRangeScan(RobotMoveRequest::RED));
-                std::unique_ptr<ExternalBoardSquare*[]> redLrs(board->getLongRangeScan());
-                std::unique_ptr<ExternalBoardSquare*[]> blueSrs(board->getShortRangeScan(RobotMoveRequest::BLUE));
-                std::unique_ptr<ExternalBoardSquare*[]> blueLrs(board->getLongRangeScan());
-
-                // Get move requests
-                std::unique_ptr<RobotMoveRequest> redMove(redRobot.getRobotAgent()->getMove(redSrs.get(), redLrs.get()));
-                std::unique_ptr<RobotMoveRequest> blueMove(blueRobot.getRobotAgent()->getMove(blueSrs.get(), blueLrs.get()));
+        RobotAgentRoster& roster = RobotAgentRoster::getInstance();
+        std::unique_ptr<IRobotAgent> redAgent(roster.spawn(redRobot.getRobotAgent()->getRobotName()));
+        std::unique_ptr<IRobotAgent> blueAgent(roster.spawn(blueRobot.getRobotAgent()->getRobotName()));
+        redAgent->setRobotColor(redRobot.getRobotColor());
+        blueAgent->setRobotColor(blueRobot.getRobotColor());
 
-                // Process moves
-                if (!processRobotMoves(redMove.get(), blueMove.get())) {
-                    break;
-                }
+        Match match(board, redAgent.get(), blueAgent.get());
+        match.setConcurrentAgents(concurrentAgents);
+        if ((concurrentAgents || boardSettings.getMoveTimeLimit() > 0) && !redWorker) {
+            redWorker.reset(new AgentWorker());
+            blueWorker.reset(new AgentWorker());
+        }
+        if (redWorker) {
+            match.setWorkers(redWorker.get(), blueWorker.get());
+        }
+        std::ofstream replayOut;
+        std::unique_ptr<ReplayWriter> recorder;
+        if (!replayFile.empty()) {
+            replayOut.open(replayFile, std::ios::binary);
+            if (!replayOut.is_open()) {
+                throw std::runtime_error("Could not create replay file: " + replayFile);
+            }
+            recorder.reset(new ReplayWriter(replayOut));
+            match.setRecorder(recorder.get());
+        }
+        int turn = 0;
+        while (!match.isOver()) {
+            bool keepPlaying;
+            {
+                PAINTBOTS_PROFILE_SCOPE(Profiler::TURN);
+                keepPlaying = match.playTurn();
+            }
+            ++turn;
+            if (quiet) {
+                continue;
+            }
+            if (!ansi) {
+                // Text below the board would scroll the ANSI display out of place
+                reportTurn(match);
+            }
+            if (!keepPlaying && match.getEndReason() != MatchResult::MOVE_LIMIT) {
+                break;
+            }
 
-                // Display updated board
-                display.display();
+            // Display updated board
+            if (turn % displayEvery == 0 || match.isOver()) {
+                showBoard(false);
                 checkPause();
+            }
+        }
+
+        MatchResult result = match.getResult();
+        if (quiet) {
+            std::cout << "Seed " << result.seed << ": red " << result.redScore
+                      << ", blue " << result.blueScore << "\n";
+        } else {
+            announceResults();
+        }
+        return result;
+    }
+
+    /**
+     * Executes the games, every game of a series plays a board derived from the 
+     * series seed like the matches of a tournament 
+     */
+    void GameLogic::playGame(const std::string& boardConfig, const std::string& robotConfig) {
+        try {
+            // Load configurations
+            Config boardSettings(boardConfig);
+            if (seedOverride) {
+                boardSettings.setSeed(seed);
+            }
+            if (games > 1 && !replayFile.empty()) {
+                throw std::invalid_argument("A replay file records a single game");
+            }
+            loadRobotStrategies(robotConfig);
+            MatchSeed seriesSeed = boardSettings.hasSeed() ? MatchSeed(boardSettings.getSeed()) : MatchSeed::random();
+            if (games > 1) {
+                std::cout << "Series seed: " << seriesSeed.value() << std::endl;
+            }
 
-                // Cleanup scans
-                for (int i = 0; i < 5; ++i) {
-                    delete[] redSrs[i];
-                    delete[] blueSrs[i];
+            PAINTBOTS_PROFILE_RESET();
+
+            int redWins = 0;
+            int blueWins = 0;
+            results.clear();
+            for (int game = 0; game < games; ++game) {
+                if (games > 1) {
+                    boardSettings.setSeed(seriesSeed.forMatch(game).value());
                 }
-                for (int i = 0; i < GameBoard::BOARD_SIZE + 2; ++i) {
-                    delete[] redLrs[i];
-                    delete[] blueLrs[i];
+                MatchResult result = playMatch(boardSettings);
+                results.push_back(result);
+                if (result.outcome() == MatchResult::RED_WIN) {
+                    ++redWins;
+                } else if (result.outcome() == MatchResult::BLUE_WIN) {
+                    ++blueWins;
                 }
             }
 
-            announceResults();
+            if (games > 1) {
+                std::cout << "\n" << games << " games: red won " << redWins << ", blue won " << blueWins
+                          << ", " << (games - redWins - blueWins) << " ties\n";
+            }
+#ifdef PAINTBOTS_PROFILE
+            const char* profileFile = "paintbots-profile.json";
+            std::ofstream profile(profileFile);
+            Profiler::current().writeJson(profile);
+            std::cout << "Timing profile written to " << profileFile << "\n";
+#endif
         }
         catch (const std::exception& e) {
             std::cerr << "Game error: " << e.what() << std::endl;
@@ -253,17 +304,129 @@ namespace Paintbots {
         pauseMode = pausemode;
     }
 
+    /**
+     * Setter for quiet mode, which also stops the display from tracking the board 
+     */
+    void GameLogic::setQuiet(bool quietMode) {
+        quiet = quietMode;
+        attachDisplay();
+    }
+
+    /**
+     * Setter for the ANSI display 
+     */
+    void GameLogic::setAnsi(bool enabled) {
+        ansi = enabled;
+        attachDisplay();
+    }
+
+    /**
+     * Setter for how often the board is shown 
+     */
+    void GameLogic::setDisplayEvery(int turns) {
+        if (turns < 1) {
+            throw std::invalid_argument("The board has to be shown every 1 or more turns");
+        }
+        displayEvery = turns;
+    }
+
+    /**
+     * Setter for the number of games 
+     */
+    void GameLogic::setGames(int count) {
+        if (count < 1) {
+            throw std::invalid_argument("At least one game has to be played");
+        }
+        games = count;
+    }
+
+    /**
+     * Setter for the match seed 
+     */
+    void GameLogic::setSeed(uint64_t matchSeed) {
+        seedOverride = true;
+        seed = matchSeed;
+    }
+
+    /**
+     * Setter for the replay file 
+     */
+    void GameLogic::setReplayFile(const std::string& fileName) {
+        replayFile = fileName;
+    }
+
+    /**
+     * Setter for concurrent move computation 
+     */
+    void GameLogic::setConcurrentAgents(bool enabled) {
+        concurrentAgents = enabled;
+    }
+
     /**
      * Starts game execution 
      */
     int GameLogic::runGame(int argc, char* argv[]) {
-        if (argc != 3) {
-            std::cerr << "Usage: " << argv[0] << " <board_config_file> <robot_config_file>\n";
+        std::string seedOption;
+        std::string replayOption;
+        std::string displayEveryOption;
+        std::string gamesOption;
+        bool concurrentOption = false;
+        bool pauseOption = true;
+        bool quietOption = false;
+        bool ansiOption = false;
+        bool validOptions = argc >= 3;
+        for (int i = 3; i < argc && validOptions; ++i) {
+            std::string arg = argv[i];
+            if (arg.compare(0, 7, "--seed=") == 0) {
+                seedOption = arg.substr(7);
+            } else if (arg.compare(0, 9, "--replay=") == 0) {
+                replayOption = arg.substr(9);
+            } else if (arg == "--concurrent") {
+                concurrentOption = true;
+            } else if (arg == "--no-pause") {
+                pauseOption = false;
+            } else if (arg == "--quiet") {
+                quietOption = true;
+            } else if (arg == "--ansi") {
+                ansiOption = true;
+            } else if (arg.compare(0, 16, "--display-every=") == 0) {
+                displayEveryOption = arg.substr(16);
+            } else if (arg.compare(0, 8, "--games=") == 0) {
+                gamesOption = arg.substr(8);
+            } else {
+                validOptions = false;
+            }
+        }
+        if (!validOptions) {
+            std::cerr << "Usage: " << argv[0] << " <board_config_file> <robot_config_file> [--seed=N] [--replay=FILE] [--concurrent]\n"
+                      << "       [--no-pause] [--quiet] [--ansi] [--display-every=N] [--games=N]\n"
+                      << "--no-pause plays without waiting for Enter, --quiet prints only the scores\n"
+                      << "of every game, --ansi draws a colored board that only redraws what changed,\n"
+                      << "--display-every shows the board every N turns and --games plays N games on\n"
+                      << "boards derived from the seed.\n";
             return 1;
         }
 
         try {
             GameLogic game;
+            if (!seedOption.empty()) {
+                game.setSeed(std::stoull(seedOption));
+            }
+            game.setReplayFile(replayOption);
+            game.setConcurrentAgents(concurrentOption);
+            game.setPause(pauseOption);
+            game.setQuiet(quietOption);
+            game.setAnsi(ansiOption);
+            if (!displayEveryOption.empty()) {
+                game.setDisplayEvery(std::stoi(displayEveryOption));
+            }
+            if (!gamesOption.empty()) {
+                int count = std::stoi(gamesOption);
+                if (count > 1 && !replayOption.empty()) {
+                    throw std::invalid_argument("--replay records a single game");
+                }
+                game.setGames(count);
+            }
             game.playGame(argv[1], argv[2]);
             return 0;
         }
@@ -273,8 +436,3 @@ namespace Paintbots {
         }
     }
 }
-
-// Main function
-int main(int argc, char* argv[]) {
-    return Paintbots::GameLogic::runGame(argc, argv);
-}
\ No newline at end of file
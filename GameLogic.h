@@ -7,7 +7,10 @@
 #include "Robot.h"
 #include "RobotAgentRoster.h"
 #include "PlainDisplay.h"
+#include "AnsiDisplay.h"
+#include "Match.h"
 #include <string>
+#include <vector>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -21,15 +24,23 @@ namespace Paintbots {
     class GameLogic {
     private:
         // Game configuration and components
-        Config& config;
-        GameBoard* board;
+        GameBoard board;
         Robot redRobot;
         Robot blueRobot;
         PlainDisplay display;
+        AnsiDisplay ansiDisplay; // redraws changed squares in place, used instead of display
         bool pauseMode;
-        
-        // Constants
-        static const int MAX_MOVES = 300;
+        bool quiet; // show no boards and print only the score of every game
+        bool ansi; // show the board with ansiDisplay
+        int displayEvery; // turns between two board displays
+        int games; // games to play in a row
+        bool seedOverride; // whether seed replaces the board config's seed
+        uint64_t seed;
+        std::string replayFile; // where to record the game, empty for no replay
+        bool concurrentAgents; // let both agents compute their moves at once
+        std::unique_ptr<AgentWorker> redWorker; // threads the agents think on, kept for every game
+        std::unique_ptr<AgentWorker> blueWorker;
+        std::vector<MatchResult> results; // every game of the last playGame
 
         /**
          * Load robot strategies from configuration file
@@ -39,36 +50,39 @@ namespace Paintbots {
         void loadRobotStrategies(const std::string& robotConfigFile);
 
         /**
-         * Handle pause mode between moves
+         * Attach the display in use to the board, none when quiet
          */
-        void checkPause();
+        void attachDisplay();
 
         /**
-         * Process robot moves and update game state
-         * @param redMove Red robot's move request
-         * @param blueMove Blue robot's move request
-         * @return true if game should continue, false if game should end
+         * Show the board on the display in use
+         * @param newGame Whether the board was just set up, which redraws it completely
          */
-        bool processRobotMoves(RobotMoveRequest* redMove, RobotMoveRequest* blueMove);
+        void showBoard(bool newGame);
 
         /**
-         * Clean up scan data
-         * @param scan Pointer to scan array
-         * @param size Size of the array
+         * Handle pause mode between moves
          */
-        void cleanupScan(ExternalBoardSquare** scan, int size);
+        void checkPause();
 
         /**
-         * Check for game-ending conditions
-         * @return true if game should end
+         * Report hits and the reason the game ended for the last turn
+         * @param match Match being played
          */
-        bool checkGameEnd() const;
+        void reportTurn(const Match& match) const;
 
         /**
          * Announce game results
          */
         void announceResults() const;
 
+        /**
+         * Play one game on a board generated from the settings
+         * @param boardSettings Board configuration, with the seed of the game if any
+         * @return Result of the game
+         */
+        MatchResult playMatch(const Config& boardSettings);
+
     public:
         /**
          * Constructor
@@ -77,18 +91,68 @@ namespace Paintbots {
         GameLogic();
 
         /**
-         * Play the game
+         * Play the game, or every game of the series
          * @param boardConfig Path to board configuration file
          * @param robotConfig Path to robot configuration file
          */
         void playGame(const std::string& boardConfig, const std::string& robotConfig);
 
+        /**
+         * Get the results of the games played by the last playGame
+         * @return One result per game, in the order played
+         */
+        const std::vector<MatchResult>& getResults() const {return results;}
+
         /**
          * Set pause mode
          * @param pausemode Whether to pause between moves
          */
         void setPause(bool pausemode);
 
+        /**
+         * Set quiet mode
+         * @param quietMode Whether to skip the board display and the turn reports
+         */
+        void setQuiet(bool quietMode);
+
+        /**
+         * Show the board with colored ANSI escape sequences, redrawing only what changed
+         * @param enabled Whether to use the ANSI display
+         */
+        void setAnsi(bool enabled);
+
+        /**
+         * Show the board only every few turns, and after the last one
+         * @param turns Turns between two displays
+         * @throws std::invalid_argument if turns is less than 1
+         */
+        void setDisplayEvery(int turns);
+
+        /**
+         * Play several games in a row
+         * @param count Games to play
+         * @throws std::invalid_argument if count is less than 1
+         */
+        void setGames(int count);
+
+        /**
+         * Set the match seed, overriding any SEED in the board config
+         * @param matchSeed Seed to generate the board and seed the robots from
+         */
+        void setSeed(uint64_t matchSeed);
+
+        /**
+         * Record the game into a binary replay log
+         * @param fileName Replay file to create, empty to stop recording
+         */
+        void setReplayFile(const std::string& fileName);
+
+        /**
+         * Let both agents compute their moves at the same time
+         * @param enabled Whether the agents think concurrently
+         */
+        void setConcurrentAgents(bool enabled);
+
         /**
          * Run the game from command line arguments
          * @param argc Argument count
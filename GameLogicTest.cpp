@@ -0,0 +1,125 @@
+#include "GameLogicTest.h"
+#include "GameLogic.h"
+#include "MatchSeed.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <vector>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    namespace {
+        const char* BOARD_CONFIG = "gamelogic-board.config";
+        const char* ROBOT_CONFIG = "gamelogic-robots.config";
+
+        /**
+         * Plays games without pausing or drawing, with a fresh roster
+         */
+        std::vector<MatchResult> playQuietly(uint64_t seed, int games) {
+            RobotAgentRoster::resetInstance();
+            GameLogic game;
+            game.setPause(false);
+            game.setQuiet(true);
+            game.setSeed(seed);
+            game.setGames(games);
+            game.playGame(BOARD_CONFIG, ROBOT_CONFIG);
+            return game.getResults();
+        }
+    }
+
+    void GameLogicTest::setUp() {
+        std::ofstream board(BOARD_CONFIG);
+        board << "HIT_DURATION = 25\n"
+              << "PAINTBLOB_LIMIT = 20\n"
+              << "ROCK_LOWER_BOUND = 5\n"
+              << "ROCK_UPPER_BOUND = 15\n"
+              << "FOG_LOWER_BOUND = 3\n"
+              << "FOG_UPPER_BOUND = 8\n"
+              << "LONG_RANGE_LIMIT = 5\n";
+        std::ofstream robots(ROBOT_CONFIG);
+        robots << "LazyRobot\n"
+               << "RandomRobot\n";
+    }
+
+    void GameLogicTest::tearDown() {
+        std::remove(BOARD_CONFIG);
+        std::remove(ROBOT_CONFIG);
+        RobotAgentRoster::resetInstance();
+    }
+
+    /**
+     * @test Testing that agent state does not carry over from one game of a series
+     * to the next
+     */
+    void GameLogicTest::testSeriesReproducesGames() {
+        const uint64_t seed = 7;
+        const int games = 4;
+        std::vector<MatchResult> series = playQuietly(seed, games);
+        assert(int(series.size()) == games);
+
+        for (int k = 0; k < games; ++k) {
+            uint64_t gameSeed = MatchSeed(seed).forMatch(k).value();
+            std::vector<MatchResult> single = playQuietly(gameSeed, 1);
+            assert(single.size() == 1);
+            assert(series[k].seed == gameSeed);
+            assert(single[0].seed == gameSeed);
+            assert(single[0].redScore == series[k].redScore);
+            assert(single[0].blueScore == series[k].blueScore);
+            assert(single[0].turns == series[k].turns);
+            assert(single[0].endReason == series[k].endReason);
+        }
+        std::cout << "Series reproduces games test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a replay file and several games are refused together
+     */
+    void GameLogicTest::testSeriesRejectsReplay() {
+        RobotAgentRoster::resetInstance();
+        GameLogic game;
+        game.setPause(false);
+        game.setQuiet(true);
+        game.setGames(2);
+        game.setReplayFile("gamelogic.pbr");
+        bool threw = false;
+        try {
+            game.playGame(BOARD_CONFIG, ROBOT_CONFIG);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+        std::ifstream replay("gamelogic.pbr");
+        assert(!replay.is_open());
+        std::cout << "Series rejects replay test: PASS\n";
+    }
+
+    bool GameLogicTest::doTests() {
+        bool allTestsPassed = true;
+        try {
+            std::cout << "-------------------------\n";
+            std::cout << "GameLogic unit tests\n";
+            std::cout << "-------------------------\n";
+
+            setUp();
+            testSeriesReproducesGames();
+            testSeriesRejectsReplay();
+            tearDown();
+
+        } catch (const std::exception& e) {
+            std::cout << "Test failed with exception: " << e.what() << std::endl;
+            allTestsPassed = false;
+        }
+
+        return allTestsPassed;
+    }
+}
+
+// Main function
+int main() {
+    Paintbots::GameLogicTest tester;
+    return tester.doTests() ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+#ifndef GAME_LOGIC_TEST_H
+#define GAME_LOGIC_TEST_H
+
+#include "ITest.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+    class GameLogicTest : public ITest {
+        private:
+            /**
+             * Writes the board and robot config files the tests play from
+             */
+            void setUp();
+
+            /**
+             * Removes the config files
+             */
+            void tearDown();
+
+            /**
+             * Tests that every game of a series plays like a single game with its seed
+             */
+            void testSeriesReproducesGames();
+
+            /**
+             * Tests that a series cannot record a replay over and over into one file
+             */
+            void testSeriesRejectsReplay();
+
+        public:
+            bool doTests() override;
+    };
+}
+
+#endif
@@ -0,0 +1,7 @@
+// GameMain.cpp
+#include "GameLogic.h"
+
+// Main function
+int main(int argc, char* argv[]) {
+    return Paintbots::GameLogic::runGame(argc, argv);
+}
@@ -4,12 +4,20 @@
 #include "ExternalBoardSquare.h"
 #include "Config.h"
 #include "ObserverPattern.h"
+#include "BoardChange.h"
+#include "ScanBuffer.h"
+#include "BitBoard.h"
+#include "MatchSeed.h"
 #include <string>
+#include <vector>
 #include <cstring>  
 #include <stdexcept>  
 #include <algorithm> 
 
 namespace Paintbots{
+
+struct BoardLayout; 
+
 /**
  * @struct Bundles all the necessary information about a robot move 
  */
@@ -36,34 +44,97 @@ class GameBoard : public Observable {
     
     public: 
 
-        static const int BOARD_SIZE = 15; // constant to hold the board size 
-        static GameBoard* getInstance(const std::string& password); // constructor to allow singleton access 
+        static const int BOARD_SIZE = 15; // default playable rows and columns, see Config BOARD_SIZE 
+        static const int MAX_SIZE = 1024; // largest supported board size 
+        static const int SHORT_RANGE_SIZE = 5; // rows and columns of a short range scan 
+        typedef DynamicScanBuffer LongRangeScan; // reusable full board view, sized to the board 
+        typedef ScanBuffer<SHORT_RANGE_SIZE> ShortRangeScan; // reusable view around a robot 
+        static GameBoard* getInstance(const std::string& password); // legacy shared board, password guarded 
+        GameBoard(); // board using the default configuration 
+        explicit GameBoard(const Config& config); // board with its own copy of the configuration, throws ConfigBoundsError if its size or pieces do not fit 
+        GameBoard(const Config& config, const BoardLayout& layout); // board starting from a stored layout and its seed, see LayoutCorpus 
+        GameBoard(const GameBoard& other) = default; // copies the full game state, but not the observers 
+        GameBoard& operator = (const GameBoard& other) = default; // replaces the game state, keeps the observers 
         ~GameBoard(); // destructor 
 
         /**
-         * Gets the square at a particular row and col 
+         * Gets the square at a particular row and col. Callers may change the square 
+         * through the reference, so the cached robot positions are refreshed afterwards 
          */
         InternalBoardSquare& getSquare(int row, int col); 
 
+        /**
+         * Gets the square at a particular row and col for reading only 
+         */
+        const InternalBoardSquare& getSquare(int row, int col) const; 
+
         /**
          * Method to move the robot 
          */
         bool moveRobot(RobotMoveRequest& mr); 
 
+        /**
+         * Starts collecting changes instead of notifying observers of each one. Batches 
+         * nest, observers get everything collected as one BoardChange when the 
+         * outermost batch ends, e.g. once per turn 
+         */
+        void beginBatch(); 
+
+        /**
+         * Ends a batch, notifying observers if it was the outermost one and anything changed 
+         */
+        void endBatch(); 
+
+        /**
+         * @class Turn 
+         * Batch covering one turn: observers hear about the turn once, on commit. A turn 
+         * dropped without a commit, e.g. by an exception, closes its batch silently and 
+         * its changes go out with the next notification 
+         */
+        class Turn {
+            public: 
+                explicit Turn(GameBoard& board) : board(&board), open(true) {
+                    board.beginBatch(); 
+                }
+
+                /**
+                 * Ends the turn and notifies the observers 
+                 */
+                void commit() {
+                    if (open) {
+                        open = false; 
+                        board->endBatch(); 
+                    }
+                }
+
+                ~Turn() {
+                    if (open) {
+                        board->abandonBatch(); 
+                    }
+                }
+
+            private: 
+                GameBoard* board; // board the turn is played on 
+                bool open; // not committed yet 
+
+                Turn(const Turn&) = delete; 
+                Turn& operator = (const Turn&) = delete; 
+        }; 
+
         /**
          * Method to handle the case when a robot gets hit with a paint blob 
          */
         bool paintBlobHit(RobotMoveRequest& mr); 
 
         /**
-         * Method to return the blue robot's score 
+         * Method to return the blue robot's score, the number of blue squares 
          */
-        int blueScore(); 
+        int blueScore() const; 
 
         /**
-         * Method to return the red robot's score 
+         * Method to return the red robot's score, the number of red squares 
          */
-        int redScore(); 
+        int redScore() const; 
 
         /**
          * Method to set the color of a particular square 
@@ -76,21 +147,64 @@ class GameBoard : public Observable {
         void setRobotPaintColor(RobotMoveRequest::RobotColor robot, SquareColor color); 
 
         /**
-         * Method to get the full view of the board 
+         * Method to get the full view of the board, the caller frees every row 
+         * and the array 
          */
         ExternalBoardSquare** getLongRangeScan(); 
 
+        /**
+         * Fills a caller owned buffer with the full view of the board, no allocation 
+         */
+        void getLongRangeScan(LongRangeScan& scan) const; 
+
         /**
          * Method to get a 5*5 view with the robot in the center with the direction of 
-         * the robot being considered up 
+         * the robot being considered up, the caller frees every row and the array 
          */
         ExternalBoardSquare** getShortRangeScan(RobotMoveRequest::RobotColor rc); 
 
+        /**
+         * Fills a caller owned buffer with the 5*5 view around a robot, no allocation 
+         */
+        void getShortRangeScan(RobotMoveRequest::RobotColor rc, ShortRangeScan& scan); 
+
         /**
          * Get remaining paint blobs for a robot
          */
         int getRemainingPaintBlobs(RobotMoveRequest::RobotColor robot) const;
 
+        /**
+         * @return true if both robots are on the same square 
+         */
+        bool robotsCollided() const; 
+
+        /**
+         * Gets the paint, rock, fog and wall layers of the board as bitboards 
+         */
+        const BitBoard& getBitBoard() const; 
+
+        /**
+         * Gets the number of playable rows and columns, the walls add one on each side 
+         */
+        int getSize() const {return size;}
+
+        /**
+         * Gets the configuration this board was created with 
+         */
+        const Config& getConfig() const {return config;}
+
+        /**
+         * Gets the seed the board was generated from, the configured one or a 
+         * random one if the config has none. Agents derive their streams from it too 
+         */
+        uint64_t getSeed() const {return seed;}
+
+        /**
+         * Gets a counter that changes whenever the squares may have changed, views of 
+         * the board use it to notice they are out of date 
+         */
+        uint64_t getVersion() const {return version;}
+
         /**
          * Cleaning up memory 
          */
@@ -102,21 +216,96 @@ class GameBoard : public Observable {
     private: 
         static GameBoard* instance; // instance for gameboard 
         static const std::string PASSWORD; // string for password 
+        static const InternalBoardSquare WALL_SENTINEL; // shown for squares outside the board 
         SquareColor redRobotPaintColor; // keeping track of what color the red robot is currently shooting 
         SquareColor blueRobotPaintColor; // keeping track of what color the blue robot is currently shooting 
-        InternalBoardSquare board[BOARD_SIZE  + 2][BOARD_SIZE + 2]; // InternalBoardSquare of correct size 
-        Config& config; // Config object for keeping track of config values 
+        int size; // playable rows and columns 
+        std::vector<InternalBoardSquare> grid; // the squares row major, walls included, size + 2 per row 
+        Config config; // Config values this board was created with 
+        uint64_t seed; // match seed the layout was generated from 
         int redPaintBlobsRemaining;    // Track remaining paint blobs for red robot
         int bluePaintBlobsRemaining;   // Track remaining paint blobs for blue robot
 
-        //Private constructors for singleton implementation 
-        GameBoard(); // default constructor 
-        GameBoard(const Config& config); // specific constructor 
-        GameBoard(const GameBoard&) = delete; // prevent copying 
-        GameBoard& operator = (const GameBoard&) = delete; // prevent assignment 
-
         int redRobotHitDuration; // var to keep track of remaining moves when it gets hit 
         int blueRobotHitDuration; // var to keep track of remaining moves when blue gets hit 
+        uint64_t version; // bumped on every change to the squares 
+
+        /**
+         * @struct Where a robot is and which way it faces, row is -1 if it is not on the board 
+         */
+        struct RobotPosition {
+            int row; 
+            int col; 
+            Direction facing; 
+        }; 
+
+        mutable RobotPosition redPosition; // cached position of the red robot 
+        mutable RobotPosition bluePosition; // cached position of the blue robot 
+        mutable BitBoard layers; // paint and obstacle layers, kept in step with the squares 
+        mutable bool squaresStale; // squares were handed out for writing, the caches must be rebuilt 
+        BoardChange pending; // changes observers have not been told about 
+        BoardChange delivered; // change being delivered, kept to reuse its storage 
+        int batchDepth; // nested beginBatch calls without their endBatch 
+
+        /**
+         * Gets the cached position of a robot, rescanning the board first if needed 
+         * @throws std::runtime_error if the robot is not on the board 
+         */
+        RobotPosition& robotPosition(RobotMoveRequest::RobotColor robot); 
+
+        /**
+         * Gets a square without bounds checks 
+         */
+        InternalBoardSquare& cell(int row, int col) {return grid[row * (size + 2) + col];}
+        const InternalBoardSquare& cell(int row, int col) const {return grid[row * (size + 2) + col];}
+
+        /**
+         * Rebuilds the robot positions and bitboard layers with a single pass over the board 
+         */
+        void rescanBoard() const; 
+
+        /**
+         * rescanBoard for a board of the given geometry 
+         */
+        template<class Geometry>
+        void rescanSquares(Geometry geometry) const; 
+
+        /**
+         * getLongRangeScan for a board of the given geometry, the scan is already sized 
+         */
+        template<class Geometry>
+        void copySquares(Geometry geometry, LongRangeScan& scan) const; 
+
+        /**
+         * Records a change and notifies the observers unless a batch is open. Boards 
+         * nobody observes record nothing 
+         */
+        void publishChange(BoardChange::Kind kind); 
+
+        /**
+         * Records a changed square if anyone observes the board 
+         */
+        void markChanged(int row, int col) {
+            if (hasObservers()) {
+                pending.markSquare(row, col); 
+            }
+        }
+
+        /**
+         * Notifies the observers of everything pending 
+         */
+        void flushChanges(); 
+
+        /**
+         * Ends a batch without notifying anyone, the changes stay pending. For Turn's 
+         * destructor, so it never throws 
+         */
+        void abandonBatch() noexcept; 
+
+        /**
+         * Colors a square and keeps the paint layers up to date 
+         */
+        void paintSquare(int row, int col, SquareColor color); 
 
         /**
          * Validates whether a position is valid 
@@ -125,6 +314,7 @@ class GameBoard : public Observable {
 
         /**
          * Initializes board 
+         * @throws ConfigBoundsError if the rocks, fog and robots cannot all fit 
          */
         void initializeBoard(); 
 
@@ -134,20 +324,17 @@ class GameBoard : public Observable {
         void placeWalls(); 
 
         /**
-         * Method to place rocks on the board 
+         * Throws ConfigBoundsError if the config allows more pieces than squares 
          */
-        void placeRocks(); 
+        void checkLayoutFeasible() const; 
 
         /**
-         * Method to place fog on the board 
+         * Method to place rocks, fog and robots on the board 
          */
-        void placeFog(); 
-
-        /**
-         * Method to place robots on the board 
-         */
-        void placeRobots(); 
+        void placeContents(); 
 
 };
+
+static_assert(GameBoard::BOARD_SIZE == BitBoard::DEFAULT_SIZE, "default boards take the bitboard ray fast path");
 }
 #endif
\ No newline at end of file
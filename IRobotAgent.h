@@ -3,7 +3,9 @@
 #define IROBOT_AGENT_H
 
 #include "GameBoard.h"
+#include "AgentContext.h"
 #include <string>
+#include <memory>
 #include <cstring>  
 
 #include <stdexcept>  
@@ -36,15 +38,76 @@ namespace Paintbots {
             virtual std::string getRobotCreator() = 0;
 
             /**
-             * Determines the next move for the robot based on the short and long range scans 
+             * Determines the next move, returned by value so a turn allocates nothing. 
+             * This is what matches call and what agents implement, requesting the long 
+             * range scan only when they need it. The default adapts agents written 
+             * against the getMove overloads below, taking ownership of the move they 
+             * return 
+             * @throws std::runtime_error if the adapted getMove returned no move 
+             */
+            virtual RobotMoveRequest nextMove(AgentContext& context) {
+                std::unique_ptr<RobotMoveRequest> move(getMove(context)); 
+                if (!move) {
+                    throw std::runtime_error("Invalid move requests"); 
+                }
+                return *move; 
+            }
+
+            /**
+             * Legacy entry point, determines the next move from the short and long range 
+             * scans and returns it on the heap. lrs is nullptr once the robot's 
+             * LONG_RANGE_LIMIT is spent, agents have to check it. Only agents that do 
+             * not implement nextMove override it 
+             * @throws std::runtime_error by default, the agent implements neither 
+             */
+            virtual RobotMoveRequest* getMove(ExternalBoardSquare** srs, 
+                                            ExternalBoardSquare** lrs) {
+                (void)srs; 
+                (void)lrs; 
+                throw std::runtime_error("Agent implements neither nextMove nor getMove"); 
+            }
+
+            /**
+             * Same as getMove above, with the board's bitboard layers for agents that 
+             * analyze the whole board, nullptr whenever lrs is. The default ignores them 
              */
             virtual RobotMoveRequest* getMove(ExternalBoardSquare** srs, 
-                                            ExternalBoardSquare** lrs) = 0;
+                                            ExternalBoardSquare** lrs, 
+                                            const BitBoard* layers) {
+                (void)layers; 
+                return getMove(srs, lrs);
+            }
+
+            /**
+             * Same as getMove above, with the context of the move. The default requests 
+             * the long range scan every move and hands it to getMove above, so lrs is 
+             * nullptr once the robot's LONG_RANGE_LIMIT is spent 
+             */
+            virtual RobotMoveRequest* getMove(AgentContext& context) {
+                ExternalBoardSquare** lrs = context.requestLongRangeScan();
+                return getMove(context.shortRangeScan(), lrs, context.requestLayers());
+            }
 
             /**
              * Sets the robot's color 
              */
             virtual void setRobotColor(RobotMoveRequest::RobotColor c) = 0;
+
+            /**
+             * Reseeds the agent's random numbers from the match seed, so a match can be 
+             * replayed exactly. Agents without randomness can ignore it 
+             */
+            virtual void setSeed(uint64_t seed) {
+                (void)seed; 
+            }
+
+            /**
+             * Tells the agent how many playable rows and columns the match board has, 
+             * before the first move. The long range scan is size + 2 squares wide 
+             */
+            virtual void setBoardSize(int size) {
+                (void)size; 
+            }
     };
 }
 
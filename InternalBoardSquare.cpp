@@ -13,47 +13,47 @@ namespace Paintbots{
         if (color != RED && color != BLUE && color != WHITE) {
             throw std::runtime_error("Invalid color!");
         }
-        squareColor = color;
+        storeField(COLOR_SHIFT, color);
     }
 
     /**
      * setting a square to have the red robot 
      */
     void InternalBoardSquare::setRedRobot(bool present){
-        if (present && hasBlueRobot){
+        if (present && blueRobotPresent()){
             throw std::runtime_error("cannot place red robot: square occupied by blue robot"); 
         }
 
-        hasRedRobot = present; 
+        storeFlag(RED_ROBOT_BIT, present); 
     }
 
     /**
      * setting a square to have the blue robot 
      */
     void InternalBoardSquare::setBlueRobot(bool present){
-        if (present && hasRedRobot){
+        if (present && redRobotPresent()){
             throw std::runtime_error("cannot place blue robot: square occupied by red robot"); 
         }
-        hasBlueRobot = present; 
+        storeFlag(BLUE_ROBOT_BIT, present); 
     }
 
     /**
      * setting correct direction of the robot 
      */
     void InternalBoardSquare::setRobotDirection(Direction dir){
-        robotFacing = dir; 
+        storeField(FACING_SHIFT, dir); 
     }
 
     /**
      * setting the correct square type 
      */
     void InternalBoardSquare::setType(SquareType newType){
-        if (squareType == ROCK && newType == FOG){
+        if (getSquareType() == ROCK && newType == FOG){
             throw std::runtime_error("Can't place fog on rock"); 
         }
-        if (squareType == FOG && newType == ROCK){
+        if (getSquareType() == FOG && newType == ROCK){
             throw std::runtime_error("Can't place rock on fog"); 
         }
-        squareType = newType; 
+        storeField(TYPE_SHIFT, newType); 
     }
 }
\ No newline at end of file
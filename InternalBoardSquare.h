@@ -4,6 +4,7 @@
 #include "BoardSquare.h"
 #include <stdexcept>
 #include <cstring>  
+#include <type_traits>
 
 #include <stdexcept>  
 #include <algorithm> 
@@ -37,7 +38,16 @@ namespace Paintbots{
              * Setting the square type correctly 
              */
             void setType(SquareType sqType); 
+
+            /**
+             * Restores the whole square from its packed state, e.g. when replaying a 
+             * recorded board 
+             */
+            void setPackedState(uint8_t packed) {state = packed;}
     }; 
+
+    static_assert(sizeof(InternalBoardSquare) == 1, "board squares must stay packed into one byte");
+    static_assert(std::is_trivially_copyable<InternalBoardSquare>::value, "boards are copied as raw memory");
 }
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "LayoutCorpus.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <vector>
+#include <unistd.h>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    namespace {
+        const char MAGIC[4] = {'P', 'B', 'L', 'C'};
+    }
+
+    /**
+     * Maps the whole file and checks the header against the file size. The descriptor
+     * is closed right away, the mapping stays valid without it
+     */
+    LayoutCorpus::LayoutCorpus(const std::string& fileName) :
+        data(nullptr),
+        length(0),
+        count(0),
+        boardSize(0),
+        recordSize(0) {
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Could not open layout corpus: " + fileName);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size < off_t(HEADER_SIZE)) {
+            ::close(fd);
+            throw std::runtime_error("Not a layout corpus: " + fileName);
+        }
+        length = static_cast<size_t>(info.st_size);
+        void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Could not map layout corpus: " + fileName);
+        }
+        data = static_cast<const uint8_t*>(mapping);
+
+        if (!std::equal(MAGIC, MAGIC + sizeof(MAGIC), data) || data[4] != VERSION) {
+            ::munmap(mapping, length);
+            throw std::runtime_error("Not a layout corpus: " + fileName);
+        }
+        boardSize = data[5] | (data[6] << 8);
+        if (boardSize < 1 || boardSize > GameBoard::MAX_SIZE) {
+            ::munmap(mapping, length);
+            throw std::runtime_error("Layout corpus has an unsupported board size: " + fileName);
+        }
+        recordSize = 8 + size_t(boardSize) * boardSize;
+        for (int i = 0; i < 4; ++i) {
+            count |= size_t(data[8 + i]) << (8 * i);
+        }
+        if (length != HEADER_SIZE + count * recordSize) {
+            ::munmap(mapping, length);
+            throw std::runtime_error("Truncated layout corpus: " + fileName);
+        }
+    }
+
+    /**
+     * Releases the mapping
+     */
+    LayoutCorpus::~LayoutCorpus() {
+        ::munmap(const_cast<uint8_t*>(data), length);
+    }
+
+    /**
+     * Decodes the seed, the squares are used in place
+     */
+    BoardLayout LayoutCorpus::at(size_t index) const {
+        if (index >= count) {
+            throw std::out_of_range("Layout " + std::to_string(index) + " is not in the corpus");
+        }
+        const uint8_t* record = data + HEADER_SIZE + index * recordSize;
+        BoardLayout layout;
+        layout.size = boardSize;
+        layout.seed = 0;
+        for (int i = 0; i < 8; ++i) {
+            layout.seed |= uint64_t(record[i]) << (8 * i);
+        }
+        layout.squares = record + 8;
+        return layout;
+    }
+
+    /**
+     * Magic, version, board size, a reserved byte and the count
+     */
+    void LayoutCorpus::writeHeader(std::ostream& out, uint32_t count, int boardSize) {
+        if (boardSize < 1 || boardSize > GameBoard::MAX_SIZE) {
+            throw std::invalid_argument("Unsupported board size " + std::to_string(boardSize));
+        }
+        uint8_t header[HEADER_SIZE] = {};
+        std::copy(MAGIC, MAGIC + sizeof(MAGIC), header);
+        header[4] = VERSION;
+        header[5] = static_cast<uint8_t>(boardSize);
+        header[6] = static_cast<uint8_t>(boardSize >> 8);
+        for (int i = 0; i < 4; ++i) {
+            header[8 + i] = static_cast<uint8_t>(count >> (8 * i));
+        }
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+
+    /**
+     * Packs the seed and the playable squares of the board
+     */
+    void LayoutCorpus::writeLayout(std::ostream& out, const GameBoard& board) {
+        int size = board.getSize();
+        std::vector<uint8_t> record(8 + size_t(size) * size);
+        uint64_t seed = board.getSeed();
+        for (int i = 0; i < 8; ++i) {
+            record[i] = static_cast<uint8_t>(seed >> (8 * i));
+        }
+        uint8_t* squares = record.data() + 8;
+        for (int row = 1; row <= size; ++row) {
+            for (int col = 1; col <= size; ++col) {
+                *squares++ = board.getSquare(row, col).packedState();
+            }
+        }
+        out.write(reinterpret_cast<const char*>(record.data()), record.size());
+    }
+}
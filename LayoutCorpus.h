@@ -0,0 +1,89 @@
+#ifndef LAYOUT_CORPUS_H
+#define LAYOUT_CORPUS_H
+
+#include "GameBoard.h"
+#include <cstdint>
+#include <string>
+#include <ostream>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @struct One starting layout as stored in a corpus, points into the corpus
+     */
+    struct BoardLayout {
+        uint64_t seed; // match seed the layout was generated from, also reseeds the agents
+        int size; // playable rows and columns
+        const uint8_t* squares; // packed state of the playable squares in row order
+    };
+
+    /**
+     * @class LayoutCorpus
+     * A file of precomputed starting layouts, memory mapped read only
+     *
+     * The file holds a header with the magic "PBLC", a version byte, the board size as
+     * 16 bits, a reserved byte and the layout count as 32 bits, followed by fixed size
+     * records: the seed as 8 little endian bytes and one packed square state per
+     * playable square. Every layout of a corpus has the same size. Layouts are read straight
+     * from the mapping, so loading a corpus costs nothing up front and workers share
+     * its pages. Files are written by paintbots-mapgen.
+     */
+    class LayoutCorpus {
+        public:
+            static const uint8_t VERSION = 1; // format version written and understood
+            static const size_t HEADER_SIZE = 12;
+
+            /**
+             * Maps a corpus file
+             * @throws std::runtime_error if the file cannot be mapped or is not a corpus
+             */
+            explicit LayoutCorpus(const std::string& fileName);
+
+            /**
+             * Unmaps the file, layouts taken from the corpus become invalid
+             */
+            ~LayoutCorpus();
+
+            /**
+             * @return number of layouts in the corpus
+             */
+            size_t size() const {return count;}
+
+            /**
+             * @return playable rows and columns of the layouts
+             */
+            int getBoardSize() const {return boardSize;}
+
+            /**
+             * Gets a layout
+             * @throws std::out_of_range past the last layout
+             */
+            BoardLayout at(size_t index) const;
+
+            /**
+             * Writes the header of a corpus of count layouts of boardSize * boardSize squares
+             */
+            static void writeHeader(std::ostream& out, uint32_t count, int boardSize = GameBoard::BOARD_SIZE);
+
+            /**
+             * Appends the starting layout of a freshly generated board, of the size
+             * given to writeHeader
+             */
+            static void writeLayout(std::ostream& out, const GameBoard& board);
+
+        private:
+            const uint8_t* data; // start of the mapping
+            size_t length; // bytes mapped
+            size_t count; // layouts in the file
+            int boardSize; // playable rows and columns of every layout
+            size_t recordSize; // bytes per layout
+
+            LayoutCorpus(const LayoutCorpus&) = delete;
+            LayoutCorpus& operator = (const LayoutCorpus&) = delete;
+    };
+}
+
+#endif
@@ -33,15 +33,23 @@ namespace Paintbots {
         return "Shobhit";
     }
 
+    /**
+     * Determines the next move from the context, reading only the short range scan 
+     */
+    RobotMoveRequest LazyRobot::nextMove(AgentContext& context) {
+        // The long range scan goes unused, so it is not asked for
+        return decideMove(context.shortRangeScan());
+    }
+
     /**
      * Determines the next move for the robot. 
      * 
-     * Analyzes the board using the short and long range scans to decide robot's movement and shooting actions 
+     * Analyzes the board using the short range scan to decide robot's movement and shooting actions 
      */
-    RobotMoveRequest* LazyRobot::getMove(ExternalBoardSquare** srs, ExternalBoardSquare** lrs) {
+    RobotMoveRequest LazyRobot::decideMove(ExternalBoardSquare** srs) {
         moveCount++;
-        RobotMoveRequest* request = new RobotMoveRequest();
-        request->robot = robotColor;
+        RobotMoveRequest request = {};
+        request.robot = robotColor;
         
         // Check surrounding squares for enemy robot
         bool enemyNearby = false;
@@ -88,22 +96,22 @@ namespace Paintbots {
             srs[1][2].getSquareType() != ROCK &&
             !srs[1][2].redRobotPresent() &&
             !srs[1][2].blueRobotPresent()) {
-                request->move = RobotMoveRequest::FORWARD;
+                request.move = RobotMoveRequest::FORWARD;
             } else {
-                request->move = (moveCount % 2 == 0) ? 
+                request.move = (moveCount % 2 == 0) ? 
                     RobotMoveRequest::ROTATELEFT : 
                     RobotMoveRequest::ROTATERIGHT;
             }
         } else {
-            request->move = RobotMoveRequest::NONE;
+            request.move = RobotMoveRequest::NONE;
         }
 
         // Only shoot if we have paintblobs and either:
         // 1. Enemy is nearby
         // 2. Random chance (1 in 3) to try to hit moving enemies
-        request->shoot = paintBlobsLeft > 0 && 
+        request.shoot = paintBlobsLeft > 0 && 
                         (enemyNearby || (std::uniform_int_distribution<>(1,3)(rng) == 1));
-        if(request->shoot) paintBlobsLeft--;
+        if(request.shoot) paintBlobsLeft--;
 
         return request;
     }
@@ -111,4 +119,12 @@ namespace Paintbots {
     void LazyRobot::setRobotColor(RobotMoveRequest::RobotColor c) {
         robotColor = c;
     }
+
+    /**
+     * Reseeds the random number generator, both halves of the seed count 
+     */
+    void LazyRobot::setSeed(uint64_t seed) {
+        std::seed_seq sequence{uint32_t(seed), uint32_t(seed >> 32)};
+        rng.seed(sequence);
+    }
 } 
\ No newline at end of file
@@ -27,6 +27,11 @@ namespace Paintbots {
             int paintBlobsLeft;  // Remaining number of paint blobs available for shooting 
             Direction lastDirection;  // Tracks the last direction the robot moved in 
 
+            /**
+             * Picks the move from the short range scan 
+             */
+            RobotMoveRequest decideMove(ExternalBoardSquare** srs);
+
         public:
             /**
              * Initializes robot's attributes 
@@ -45,15 +50,19 @@ namespace Paintbots {
             std::string getRobotCreator() override;
 
             /**
-             * Analyzes the short-range and long-range scans in order to make a decision 
+             * Decides from the short range scan alone, the long range scan is never built 
              */
-            RobotMoveRequest* getMove(ExternalBoardSquare** srs, 
-                                    ExternalBoardSquare** lrs) override;
+            RobotMoveRequest nextMove(AgentContext& context) override;
 
             /**
              * Sets the robot's color 
              */
             void setRobotColor(RobotMoveRequest::RobotColor c) override;
+
+            /**
+             * Reseeds the random number generator from the match seed 
+             */
+            void setSeed(uint64_t seed) override;
     };
 }
 
@@ -0,0 +1,79 @@
+// MapgenMain.cpp
+#include "LayoutCorpus.h"
+#include "MatchSeed.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+    /**
+     * Prints command line usage
+     */
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " <board_config_file> <corpus_file> [--count=N] [--seed=N]\n"
+                  << "Generates N board layouts (default 100) from the config and writes them\n"
+                  << "to a corpus file for paintbots-tournament --maps. The same seed writes\n"
+                  << "the same corpus.\n";
+    }
+}
+
+// Main function
+int main(int argc, char* argv[]) {
+    using namespace Paintbots;
+
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        long count = 100;
+        std::string seed;
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.compare(0, 8, "--count=") == 0) {
+                count = std::stol(arg.substr(8));
+                if (count < 0 || count > long(UINT32_MAX)) {
+                    throw std::invalid_argument("--count out of range");
+                }
+            } else if (arg.compare(0, 7, "--seed=") == 0) {
+                seed = arg.substr(7);
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+
+        Config config(argv[1]);
+        if (!seed.empty()) {
+            config.setSeed(std::stoull(seed));
+        }
+        MatchSeed masterSeed = config.hasSeed() ? MatchSeed(config.getSeed()) : MatchSeed::random();
+
+        std::ofstream out(argv[2], std::ios::binary);
+        if (!out.is_open()) {
+            throw std::runtime_error(std::string("Could not create corpus file: ") + argv[2]);
+        }
+        LayoutCorpus::writeHeader(out, static_cast<uint32_t>(count), config.getBoardSize());
+        for (long i = 0; i < count; ++i) {
+            config.setSeed(masterSeed.forMatch(i).value());
+            GameBoard board(config);
+            LayoutCorpus::writeLayout(out, board);
+        }
+        out.close();
+        if (!out) {
+            throw std::runtime_error(std::string("Could not write corpus file: ") + argv[2]);
+        }
+
+        std::cout << "Wrote " << count << " layouts to " << argv[2] << ", seed " << masterSeed.value() << "\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Mapgen error: " << e.what() << std::endl;
+        return 1;
+    }
+}
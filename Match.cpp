@@ -0,0 +1,292 @@
+#include "Match.h"
+#include "Replay.h"
+#include "Profiler.h"
+#include <memory>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * Sets up a match on an already initialized board
+     */
+    Match::Match(GameBoard& board, IRobotAgent* redAgent, IRobotAgent* blueAgent) :
+        board(board),
+        redAgent(redAgent),
+        blueAgent(blueAgent),
+        turns(0),
+        over(false),
+        redHit(false),
+        blueHit(false),
+        endReason(MatchResult::MOVE_LIMIT),
+        recorder(nullptr),
+        moveTimeLimit(board.getConfig().getMoveTimeLimit()),
+        concurrentAgents(false),
+        redWorker(nullptr),
+        blueWorker(nullptr),
+        lentRed(nullptr),
+        lentBlue(nullptr),
+        redTimeouts(0),
+        blueTimeouts(0),
+        redScansLeft(board.getConfig().getLongRangeLimit()),
+        blueScansLeft(board.getConfig().getLongRangeLimit()) {
+        if (redAgent == nullptr || blueAgent == nullptr) {
+            throw std::invalid_argument("Match needs an agent for both robots");
+        }
+
+        MatchSeed seed(board.getSeed());
+        redAgent->setSeed(seed.derive(MatchSeed::RED_AGENT));
+        blueAgent->setSeed(seed.derive(MatchSeed::BLUE_AGENT));
+        redAgent->setBoardSize(board.getSize());
+        blueAgent->setBoardSize(board.getSize());
+    }
+
+    /**
+     * Applies the paint blob shots and then the moves of both robots
+     */
+    bool Match::processRobotMoves(RobotMoveRequest& redMove, RobotMoveRequest& blueMove) {
+        // Process paint blob hits first
+        redHit = board.paintBlobHit(redMove);
+        blueHit = board.paintBlobHit(blueMove);
+
+        // Perform moves
+        bool redMoveResult = board.moveRobot(redMove);
+        bool blueMoveResult = board.moveRobot(blueMove);
+
+        // Check for invalid moves or collisions
+        if (!redMoveResult || !blueMoveResult) {
+            endReason = MatchResult::INVALID_MOVE;
+            return false;
+        }
+
+        if (board.robotsCollided()) {
+            endReason = MatchResult::COLLISION;
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Lent workers may still hold a late move of our agents, which go away with us
+     */
+    Match::~Match() {
+        if (lentRed) {
+            lentRed->release();
+        }
+        if (lentBlue) {
+            lentBlue->release();
+        }
+    }
+
+    /**
+     * One worker per agent instance, two robots sharing an agent share its worker so
+     * the agent is never called from two threads at once
+     */
+    void Match::startWorkers() {
+        if (redWorker) {
+            return;
+        }
+        if (lentRed) {
+            redWorker = lentRed;
+        } else {
+            ownRed.reset(new AgentWorker());
+            redWorker = ownRed.get();
+        }
+        if (blueAgent != redAgent) {
+            if (lentBlue) {
+                blueWorker = lentBlue;
+            } else {
+                ownBlue.reset(new AgentWorker());
+                blueWorker = ownBlue.get();
+            }
+        }
+    }
+
+    /**
+     * Switches concurrent move computation on or off
+     */
+    void Match::setConcurrentAgents(bool enabled) {
+        concurrentAgents = enabled;
+    }
+
+    /**
+     * Only remembers the workers, they are picked up on the first turn that needs them
+     */
+    void Match::setWorkers(AgentWorker* red, AgentWorker* blue) {
+        if (turns != 0) {
+            throw std::runtime_error("Workers have to be set before the first turn");
+        }
+        if (red == nullptr || blue == nullptr || red == blue) {
+            throw std::invalid_argument("Match needs a worker for each robot");
+        }
+        lentRed = red;
+        lentBlue = blue;
+    }
+
+    /**
+     * Calls the agent directly if it has no worker, otherwise hands the move to the
+     * worker and waits for it. Either way the agent's time is profiled on the thread
+     * running it
+     */
+    RobotMoveRequest Match::requestMove(IRobotAgent* agent, AgentWorker* worker, AgentContext& context,
+                                        int& timeouts) {
+        RobotMoveRequest::RobotColor robot = context.getRobot();
+        if (!worker) {
+            PAINTBOTS_PROFILE_SCOPE(robot == RobotMoveRequest::RED ? Profiler::RED_AGENT : Profiler::BLUE_AGENT);
+            RobotMoveRequest move = agent->nextMove(context);
+            scansLeft(robot) = context.longRangeScansLeft();
+            return move;
+        }
+
+        AgentWorker::Clock::time_point deadline = AgentWorker::Clock::now() + moveTimeLimit;
+        bool started = worker->begin(agent, robot, robot == RobotMoveRequest::RED ? redSrs : blueSrs, board,
+                                     context.longRangeScansLeft(), moveTimeLimit.count() > 0);
+        return awaitMove(worker, started, deadline, robot, timeouts);
+    }
+
+    /**
+     * Picks the robot's counter
+     */
+    int& Match::scansLeft(RobotMoveRequest::RobotColor robot) {
+        return robot == RobotMoveRequest::RED ? redScansLeft : blueScansLeft;
+    }
+
+    /**
+     * Without a time limit waits as long as the agent needs, otherwise gives up at the
+     * deadline and substitutes a move that does nothing. The worker's profiler is never
+     * written out, so the agent's time it measured is recorded here, on the match thread
+     */
+    RobotMoveRequest Match::awaitMove(AgentWorker* worker, bool started, AgentWorker::Clock::time_point deadline,
+                                      RobotMoveRequest::RobotColor color, int& timeouts) {
+        RobotMoveRequest move = {};
+        if (started) {
+            bool finished = true;
+            if (moveTimeLimit.count() == 0) {
+                worker->finish(move);
+            } else {
+                finished = worker->finish(deadline, move);
+            }
+            if (finished) {
+                if (worker->usedLongRangeScan()) {
+                    --scansLeft(color);
+                }
+                PAINTBOTS_PROFILE_RECORD(color == RobotMoveRequest::RED ? Profiler::RED_AGENT : Profiler::BLUE_AGENT,
+                                         worker->lastMoveNanoseconds());
+                return move;
+            }
+        }
+
+        ++timeouts;
+        move.robot = color;
+        move.move = RobotMoveRequest::NONE;
+        move.shoot = false;
+        return move;
+    }
+
+    /**
+     * Gets scans and moves from both agents and applies them to the board
+     */
+    bool Match::playTurn() {
+        if (over) {
+            return false;
+        }
+
+        if ((concurrentAgents || moveTimeLimit.count() > 0) && !redWorker) {
+            startWorkers();
+        }
+
+        // Refill the short range scans, the long range views only copy the board if read
+        {
+            PAINTBOTS_PROFILE_SCOPE(Profiler::SCANS);
+            board.getShortRangeScan(RobotMoveRequest::RED, redSrs);
+            board.getShortRangeScan(RobotMoveRequest::BLUE, blueSrs);
+        }
+        const BitBoard& layers = board.getBitBoard();
+        BoardView redView(board, redLrs);
+        BoardView blueView(board, blueLrs);
+        AgentContext redContext(RobotMoveRequest::RED, redSrs, redView, layers, redScansLeft);
+        AgentContext blueContext(RobotMoveRequest::BLUE, blueSrs, blueView, layers, blueScansLeft);
+
+        // Get move requests
+        RobotMoveRequest redMove;
+        RobotMoveRequest blueMove;
+        if (concurrentAgents && blueWorker) {
+            // Start both agents, then wait for both before any move is applied
+            PAINTBOTS_PROFILE_SCOPE(Profiler::BOTH_AGENTS);
+            AgentWorker::Clock::time_point deadline = AgentWorker::Clock::now() + moveTimeLimit;
+            bool copyBoard = moveTimeLimit.count() > 0;
+            bool redStarted = redWorker->begin(redAgent, RobotMoveRequest::RED, redSrs, board, redScansLeft, copyBoard);
+            bool blueStarted = blueWorker->begin(blueAgent, RobotMoveRequest::BLUE, blueSrs, board, blueScansLeft,
+                                                 copyBoard);
+            redMove = awaitMove(redWorker, redStarted, deadline, RobotMoveRequest::RED, redTimeouts);
+            blueMove = awaitMove(blueWorker, blueStarted, deadline, RobotMoveRequest::BLUE, blueTimeouts);
+        } else {
+            AgentWorker* blueRunner = blueWorker ? blueWorker : redWorker;
+            redMove = requestMove(redAgent, redWorker, redContext, redTimeouts);
+            blueMove = requestMove(blueAgent, blueRunner, blueContext, blueTimeouts);
+        }
+
+        ++turns;
+        bool movesApplied;
+        {
+            // Observers hear about the whole turn at once
+            PAINTBOTS_PROFILE_SCOPE(Profiler::ROBOT_MOVES);
+            GameBoard::Turn turn(board);
+            movesApplied = processRobotMoves(redMove, blueMove);
+            turn.commit();
+        }
+        if (!movesApplied) {
+            over = true;
+        } else if (turns >= MAX_MOVES) {
+            endReason = MatchResult::MOVE_LIMIT;
+            over = true;
+        }
+
+        if (recorder) {
+            recorder->recordTurn(board, redMove, blueMove, redHit, blueHit);
+            if (over) {
+                recorder->end(getResult());
+            }
+        }
+
+        return !over;
+    }
+
+    /**
+     * Starts the replay log with the layout the match begins on
+     */
+    void Match::setRecorder(ReplayWriter* writer) {
+        if (turns != 0) {
+            throw std::runtime_error("Recording has to start before the first turn");
+        }
+        recorder = writer;
+        if (recorder) {
+            recorder->begin(board);
+        }
+    }
+
+    /**
+     * Plays the match to the end
+     */
+    MatchResult Match::play() {
+        while (playTurn()) {}
+        return getResult();
+    }
+
+    /**
+     * Gets the scores and the reason the match ended
+     */
+    MatchResult Match::getResult() const {
+        MatchResult result;
+        result.redScore = board.redScore();
+        result.blueScore = board.blueScore();
+        result.turns = turns;
+        result.endReason = endReason;
+        result.seed = board.getSeed();
+        result.redTimeouts = redTimeouts;
+        result.blueTimeouts = blueTimeouts;
+        return result;
+    }
+}
@@ -0,0 +1,224 @@
+#ifndef MATCH_H
+#define MATCH_H
+
+#include "GameBoard.h"
+#include "IRobotAgent.h"
+#include "AgentWorker.h"
+#include <memory>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    class ReplayWriter;
+
+    /**
+     * @struct Bundles the outcome of a finished match
+     */
+    struct MatchResult {
+
+        enum Outcome {
+            RED_WIN,
+            BLUE_WIN,
+            TIE
+        };
+
+        enum EndReason {
+            MOVE_LIMIT,     // all turns were played
+            INVALID_MOVE,   // a robot asked for a move the board rejected
+            COLLISION       // both robots ended up on the same square
+        };
+
+        int redScore;
+        int blueScore;
+        int turns;
+        EndReason endReason;
+        uint64_t seed; // replays the match when used as the board seed
+        int redTimeouts; // moves red failed to deliver within the move time limit
+        int blueTimeouts; // moves blue failed to deliver within the move time limit
+
+        /**
+         * Works out the winner from the final scores
+         */
+        Outcome outcome() const {
+            if (redScore > blueScore) return RED_WIN;
+            if (blueScore > redScore) return BLUE_WIN;
+            return TIE;
+        }
+    };
+
+    /**
+     * @class Match
+     * Plays a single game between two robot agents on a given board
+     *
+     * Holds no display or console state, so it can be driven turn by turn by the
+     * interactive GameLogic or run to completion by headless callers such as the
+     * tournament runner.
+     *
+     * If the board's config sets a move time limit, each agent thinks on an
+     * AgentWorker of its own. An agent that misses the deadline makes no move that
+     * turn, and the miss is counted in the result. Workers are also used when the
+     * agents are asked to think concurrently, see setConcurrentAgents. The match
+     * starts its own workers unless the caller lends it some with setWorkers.
+     *
+     * Agents pull the long range scan from their AgentContext. Each robot gets the
+     * config's LONG_RANGE_LIMIT of them per match, and a move that runs out of time
+     * is not charged for the scan it took.
+     */
+    class Match {
+        public:
+            static const int MAX_MOVES = 300; // number of turns in a full match
+
+            /**
+             * Sets up a match on the board with the given agents and reseeds the agents
+             * from the board's seed. The agents are not owned
+             */
+            Match(GameBoard& board, IRobotAgent* redAgent, IRobotAgent* blueAgent);
+
+            /**
+             * Waits for the agents still running on lent workers
+             */
+            ~Match();
+
+            /**
+             * Plays one turn for both robots
+             * @return true if the match should continue, false once it is over
+             */
+            bool playTurn();
+
+            /**
+             * Plays turns until the match is over
+             * @return the final result
+             */
+            MatchResult play();
+
+            /**
+             * @return true once the match has ended
+             */
+            bool isOver() const {return over;}
+
+            /**
+             * @return true if the red robot's paint blob hit blue on the last turn
+             */
+            bool redHitLastTurn() const {return redHit;}
+
+            /**
+             * @return true if the blue robot's paint blob hit red on the last turn
+             */
+            bool blueHitLastTurn() const {return blueHit;}
+
+            /**
+             * @return number of moves the red robot lost to the move time limit
+             */
+            int getRedTimeouts() const {return redTimeouts;}
+
+            /**
+             * @return number of moves the blue robot lost to the move time limit
+             */
+            int getBlueTimeouts() const {return blueTimeouts;}
+
+            /**
+             * @return long range scans a robot may still request in this match
+             */
+            int getLongRangeScansLeft(RobotMoveRequest::RobotColor robot) const {
+                return robot == RobotMoveRequest::RED ? redScansLeft : blueScansLeft;
+            }
+
+            /**
+             * @return why the match ended, MOVE_LIMIT while it is still running
+             */
+            MatchResult::EndReason getEndReason() const {return endReason;}
+
+            /**
+             * Gets the result of the match so far
+             */
+            MatchResult getResult() const;
+
+            /**
+             * Records the match into a replay log, starting with the current layout.
+             * The writer is not owned and has to be set before the first turn
+             */
+            void setRecorder(ReplayWriter* writer);
+
+            /**
+             * Lets both agents compute their moves at the same time, each on a worker
+             * thread, instead of red first and then blue. The board still applies the
+             * moves in a fixed order, so results do not change. Ignored when both robots
+             * are driven by the same agent instance, which cannot think for both at once
+             */
+            void setConcurrentAgents(bool enabled);
+
+            /**
+             * Runs the agents on workers kept by the caller, e.g. across the matches of a
+             * tournament thread, instead of starting threads for this match. Has to be
+             * called before the first turn, the workers are not owned and are released
+             * when the match goes away
+             */
+            void setWorkers(AgentWorker* red, AgentWorker* blue);
+
+        private:
+            GameBoard& board; // board the match is played on
+            IRobotAgent* redAgent; // strategy for the red robot
+            IRobotAgent* blueAgent; // strategy for the blue robot
+            int turns; // number of turns played
+            bool over; // whether the match has ended
+            bool redHit; // red hit blue on the last turn
+            bool blueHit; // blue hit red on the last turn
+            MatchResult::EndReason endReason; // why the match ended
+            ReplayWriter* recorder; // replay log of the match, if one is kept
+            std::chrono::microseconds moveTimeLimit; // per move budget, zero for none
+            bool concurrentAgents; // both agents think at once
+            AgentWorker* redWorker; // threads running the agents, null if called directly
+            AgentWorker* blueWorker; // null as well if blue shares red's agent
+            AgentWorker* lentRed; // workers set by setWorkers, null to start our own
+            AgentWorker* lentBlue;
+            std::unique_ptr<AgentWorker> ownRed; // workers started by the match itself
+            std::unique_ptr<AgentWorker> ownBlue;
+            int redTimeouts; // moves lost to the time limit
+            int blueTimeouts;
+            int redScansLeft; // long range scans left of the LONG_RANGE_LIMIT budget
+            int blueScansLeft;
+            GameBoard::ShortRangeScan redSrs; // scans handed to the agents, refilled every turn
+            GameBoard::ShortRangeScan blueSrs;
+            GameBoard::LongRangeScan redLrs; // filled only when an agent reads its long range view
+            GameBoard::LongRangeScan blueLrs;
+
+            /**
+             * Applies both robot moves to the board
+             * @return true if the match should continue
+             */
+            bool processRobotMoves(RobotMoveRequest& redMove, RobotMoveRequest& blueMove);
+
+            /**
+             * Gets a move from an agent, on its worker under the time limit if there is one
+             * @return the move, or a NONE move if the agent ran out of time
+             */
+            RobotMoveRequest requestMove(IRobotAgent* agent, AgentWorker* worker, AgentContext& context,
+                                         int& timeouts);
+
+            /**
+             * @return the long range scan budget of a robot
+             */
+            int& scansLeft(RobotMoveRequest::RobotColor robot);
+
+            /**
+             * Collects a move handed to a worker
+             * @param started Whether the worker accepted the move, false if still busy
+             * @return the move, or a NONE move if the agent ran out of time
+             */
+            RobotMoveRequest awaitMove(AgentWorker* worker, bool started, AgentWorker::Clock::time_point deadline,
+                                       RobotMoveRequest::RobotColor color, int& timeouts);
+
+            /**
+             * Picks the agent workers, a single one if both robots share an agent
+             */
+            void startWorkers();
+
+            Match(const Match&) = delete;
+            Match& operator = (const Match&) = delete;
+    };
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef MATCH_SEED_H
+#define MATCH_SEED_H
+
+#include <cstdint>
+#include <random>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class MatchSeed
+     * The single seed a match is played from, and the streams derived from it
+     *
+     * Board generation and every agent draw from their own stream, derived from the
+     * match seed with splitmix64, so adding a random call in one component does not
+     * shift the numbers another one sees. Replaying a match only needs its seed.
+     */
+    class MatchSeed {
+        public:
+
+            /**
+             * @enum Components that draw random numbers during a match
+             */
+            enum Stream {
+                ROCKS = 1,  // how many rocks
+                FOG,        // how many fog squares
+                LAYOUT,     // the squares rocks, fog and robots are placed on
+                RED_AGENT,
+                BLUE_AGENT
+            };
+
+            /**
+             * Wraps a seed
+             */
+            explicit MatchSeed(uint64_t seed) : seed(seed) {}
+
+            /**
+             * Draws a seed from the system's entropy source
+             */
+            static MatchSeed random() {
+                std::random_device device;
+                return MatchSeed((uint64_t(device()) << 32) ^ device());
+            }
+
+            /**
+             * @return the seed itself
+             */
+            uint64_t value() const {return seed;}
+
+            /**
+             * Gets the seed for one component of the match
+             */
+            uint64_t derive(Stream stream) const {
+                return mix(seed + uint64_t(stream) * GOLDEN_GAMMA);
+            }
+
+            /**
+             * Gets the seed of the n-th match in a series played from this seed
+             */
+            MatchSeed forMatch(uint64_t index) const {
+                return MatchSeed(mix(mix(seed) + (index + 1) * GOLDEN_GAMMA));
+            }
+
+            /**
+             * splitmix64 finalizer, spreads every input bit over the whole output
+             */
+            static uint64_t mix(uint64_t x) {
+                x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+                return x ^ (x >> 31);
+            }
+
+        private:
+            static const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL; // splitmix64 increment
+            uint64_t seed; // the match seed
+    };
+}
+
+#endif
@@ -12,6 +12,7 @@
 namespace Paintbots {
 
     class Observable; 
+    class BoardChange; 
 
     class Observer {
         public: 
@@ -24,6 +25,15 @@ namespace Paintbots {
              * Updates for observables 
              */
             virtual void update(Observable* subject) = 0; 
+
+            /**
+             * Updates with what changed since the last notification. Observers that 
+             * redraw everything anyway can leave it to update(subject) 
+             */
+            virtual void update(Observable* subject, const BoardChange& change) {
+                (void)change; 
+                update(subject); 
+            }
     }; 
 
     class Observable {
@@ -34,6 +44,20 @@ namespace Paintbots {
             std::vector<Observer*> observers; 
 
         public: 
+            Observable() = default; 
+
+            /**
+             * Copies start without observers, they watch a particular instance 
+             */
+            Observable(const Observable&) {}
+
+            /**
+             * Assignment keeps the current observers of the target 
+             */
+            Observable& operator = (const Observable&) {
+                return *this; 
+            }
+
             /**
              * Virtual desctructor for observable 
              */
@@ -63,11 +87,33 @@ namespace Paintbots {
              * Method to notify observers about state changes 
              */
             void notifyObservers() {
+                if (observers.empty()) {
+                    return; 
+                }
                 for (Observer* observer : observers) {
                     observer->update(this); 
                 }
             }
             
+            /**
+             * Method to notify observers about a change they can apply incrementally 
+             */
+            void notifyObservers(const BoardChange& change) {
+                if (observers.empty()) {
+                    return; 
+                }
+                for (Observer* observer : observers) {
+                    observer->update(this, change); 
+                }
+            }
+
+            /**
+             * @return true if anyone is watching 
+             */
+            bool hasObservers() const {
+                return !observers.empty(); 
+            }
+
             /**
              * Method to get observers 
              */
@@ -1,6 +1,5 @@
 #include "PlainDisplay.h"
 #include <iostream>
-#include <iomanip>
 #include <cstring> 
 
 #include <stdexcept>  
@@ -11,96 +10,130 @@ namespace Paintbots {
 /**
  * Default constructor for PlainDisplay 
  */
-PlainDisplay::PlainDisplay() {
-    initializeBoard();
+PlainDisplay::PlainDisplay() : 
+    stride(0), 
+    labelWidth(0), 
+    headerLength(0), 
+    rowLength(0), 
+    shownBoard(nullptr) {
+    initializeBoard(GameBoard::BOARD_SIZE);
 }
 
 /**
- * Initializes  the display board with default values 
+ * Lays out the labels and newlines once, so a refresh only copies cells into 
+ * their fixed offsets 
  */
-void PlainDisplay::initializeBoard() {
-    displayBoard.resize(BOARD_SIZE + 2);
-    for (auto& row : displayBoard) {
-        row.resize(BOARD_SIZE + 2);
-        for (auto& square : row) {
-            square = "W---";
+void PlainDisplay::initializeBoard(int size) {
+    stride = size + 2;
+    labelWidth = std::max(2, static_cast<int>(std::to_string(stride - 1).size()));
+    headerLength = labelWidth + 1 + size_t(stride) * (labelWidth + 1) + 1;
+    rowLength = labelWidth + 1 + size_t(stride) * (CELL_WIDTH + 1) + 1;
+    frame.assign(headerLength + size_t(stride) * rowLength, ' ');
+
+    // Column numbers
+    for (int j = 0; j < stride; j++) {
+        padNumber(j, &frame[labelWidth + 1 + size_t(j) * (labelWidth + 1)]);
+    }
+    frame[headerLength - 1] = '\n';
+
+    // Row numbers and white squares
+    BoardSquare blank;
+    for (int i = 0; i < stride; i++) {
+        padNumber(i, &frame[headerLength + size_t(i) * rowLength]);
+        for (int j = 0; j < stride; j++) {
+            setCell(i, j, blank);
         }
+        frame[headerLength + size_t(i + 1) * rowLength - 1] = '\n';
     }
 }
 
 /**
  * The number to format 
  */
-std::string PlainDisplay::padNumber(int num) {
-    return (num < 10 ? " " : "") + std::to_string(num);
+void PlainDisplay::padNumber(int num, char* label) const {
+    for (int k = labelWidth - 1; k >= 0; k--) {
+        label[k] = (num > 0 || k == labelWidth - 1) ? static_cast<char>('0' + num % 10) : ' ';
+        num /= 10;
+    }
 }
 
 /**
  * Generates the visual representation of a square based on its attributes 
  * (such as color, robot presence and special features)
  */
-std::string PlainDisplay::getSquareRepresentation(const ExternalBoardSquare& square) {
-    std::string repr;
-    
+void PlainDisplay::getSquareRepresentation(const BoardSquare& square, char* cell) {
+    // Override for walls
+    if (square.getSquareType() == WALL) {
+        std::memcpy(cell, "WWWW", CELL_WIDTH);
+        return;
+    }
+
     // First character: Board color (R/B/W)
     switch(square.getSquareColor()) {
-        case RED: repr = "R"; break;
-        case BLUE: repr = "B"; break;
+        case RED: cell[0] = 'R'; break;
+        case BLUE: cell[0] = 'B'; break;
         case WHITE: 
-        default: repr = "W"; break;
+        default: cell[0] = 'W'; break;
     }
-    
+
     // Second character: Robot presence (R/B/-)
     if (square.redRobotPresent()) {
-        repr += "R";
+        cell[1] = 'R';
     } else if (square.blueRobotPresent()) {
-        repr += "B";
+        cell[1] = 'B';
     } else {
-        repr += "-";
+        cell[1] = '-';
     }
-    
+
     // Third character: Rock presence (X/-)
-    if (square.getSquareType() == ROCK) {
-        repr += "X";
-    } else {
-        repr += "-";
-    }
-    
+    cell[2] = square.getSquareType() == ROCK ? 'X' : '-';
+
     // Fourth character: Fog presence (X/-)
-    if (square.getSquareType() == FOG) {
-        repr += "X";
-    } else {
-        repr += "-";
-    }
-    
-    // Override for walls
-    if (square.getSquareType() == WALL) {
-        return "WWWW";
-    }
-    
-    return repr;
+    cell[3] = square.getSquareType() == FOG ? 'X' : '-';
+}
+
+/**
+ * Formats every combination of color, type, robots and facing once, indexed by 
+ * the packed byte they make up 
+ */
+const char* PlainDisplay::cellFor(uint8_t packedState) {
+    static const std::vector<char> cells = [] {
+        std::vector<char> table(256 * CELL_WIDTH);
+        for (int color = 0; color < 4; color++) {
+            for (int type = 0; type < 4; type++) {
+                for (int facing = 0; facing < 4; facing++) {
+                    for (int robots = 0; robots < 4; robots++) {
+                        BoardSquare square(static_cast<SquareColor>(color), (robots & 1) != 0, (robots & 2) != 0,
+                                           static_cast<Direction>(facing), static_cast<SquareType>(type));
+                        getSquareRepresentation(square, &table[size_t(square.packedState()) * CELL_WIDTH]);
+                    }
+                }
+            }
+        }
+        return table;
+    }();
+    return &cells[size_t(packedState) * CELL_WIDTH];
 }
 
 /**
  * Retrieves the latest state of the game board and updates the internal 
  * representation of the display board to reflect the changes 
  */
-void PlainDisplay::updateBoardState(GameBoard* board) {
+void PlainDisplay::updateBoardState(const GameBoard* board) {
     if (!board) return;
     
-    ExternalBoardSquare** scan = board->getLongRangeScan();
-    
-    for (int i = 0; i < BOARD_SIZE + 2; i++) {
-        for (int j = 0; j < BOARD_SIZE + 2; j++) {
-            displayBoard[i][j] = getSquareRepresentation(scan[i][j]);
-        }
+    if (stride != board->getSize() + 2) {
+        initializeBoard(board->getSize());
     }
+    GameBoard::LongRangeScan scan;
+    board->getLongRangeScan(scan);
     
-    // Cleanup scan memory
-    for (int i = 0; i < BOARD_SIZE + 2; i++) {
-        delete[] scan[i];
+    for (int i = 0; i < stride; i++) {
+        for (int j = 0; j < stride; j++) {
+            setCell(i, j, scan[i][j]);
+        }
     }
-    delete[] scan;
+    shownBoard = board;
 }
 
 /**
@@ -114,25 +147,25 @@ void PlainDisplay::update(Observable* subject) {
 }
 
 /**
- * Renders the game board to the console 
+ * Rewrites the cells of the changed squares only, once the display holds the board 
  */
-void PlainDisplay::display() {
-    // Print column numbers
-    std::cout << "   ";
-    for (int j = 0; j < BOARD_SIZE + 2; j++) {
-        std::cout << padNumber(j) << " ";
-    }
-    std::cout << "\n";
-    
-    // Print board with row numbers
-    for (int i = 0; i < BOARD_SIZE + 2; i++) {
-        std::cout << padNumber(i) << " ";
-        
-        for (int j = 0; j < BOARD_SIZE + 2; j++) {
-            std::cout << displayBoard[i][j] << " ";
-        }
-        std::cout << "\n";
+void PlainDisplay::update(Observable* subject, const BoardChange& change) {
+    const GameBoard* board = static_cast<GameBoard*>(subject);
+    if (!board) return;
+    if (board != shownBoard || change.getStride() != stride) {
+        updateBoardState(board);
+        return;
     }
+    change.forEachDirty([&](int row, int col) {
+        setCell(row, col, ExternalBoardSquare(board->getSquare(row, col)));
+    });
+}
+
+/**
+ * Renders the game board to the console, the frame is already formatted 
+ */
+void PlainDisplay::display() {
+    std::cout.write(frame.data(), frame.size());
 }
 
 }
\ No newline at end of file
@@ -14,29 +14,56 @@
 namespace Paintbots {
     class PlainDisplay : public Observer {
         private: 
-            static const int BOARD_SIZE = 15; // constant to set the board size 
-            std::vector<std::vector<std::string>> displayBoard; // vector of strings to print out the board 
+            static const int CELL_WIDTH = 4; // characters per square, a space follows each 
+
+            std::vector<char> frame; // the whole printed board, labels and newlines included 
+            int stride; // rows and columns shown, walls included 
+            int labelWidth; // characters per row and column number 
+            size_t headerLength; // characters of the column number line 
+            size_t rowLength; // characters of one board row 
+            const GameBoard* shownBoard; // board the display was last fully refreshed from 
 
             /**
-             * Fills the display board with placeholder values to represent empty, white squares 
+             * Lays out the frame with placeholder values to represent empty, white squares 
+             * for a board of size playable rows and columns 
              */
-            void initializeBoard();
+            void initializeBoard(int size);
 
             /**
              * Determines visual representation of a square based on its attributes 
+             * @param cell Receives CELL_WIDTH characters 
+             */
+            static void getSquareRepresentation(const BoardSquare& square, char* cell);
+
+            /**
+             * Gets the cell of every packed square state, built on first use 
+             */
+            static const char* cellFor(uint8_t packedState);
+
+            /**
+             * Points to the cell of a square in the frame 
              */
-            std::string getSquareRepresentation(const ExternalBoardSquare& square);
+            char* cellAt(int row, int col) {
+                return &frame[headerLength + size_t(row) * rowLength + labelWidth + 1 + size_t(col) * (CELL_WIDTH + 1)];
+            }
+
+            /**
+             * Writes the cell of a square into the frame 
+             */
+            void setCell(int row, int col, const BoardSquare& square) {
+                std::memcpy(cellAt(row, col), cellFor(square.packedState()), CELL_WIDTH);
+            }
 
             /**
              * Retrieves the latest state of the game board and updates the internal 
              * representation of the display board
              */
-            void updateBoardState(GameBoard* board); 
+            void updateBoardState(const GameBoard* board); 
 
             /**
-             * Ensures single digit numbers are padded with space for proper allignment 
+             * Right aligns a row or column number in labelWidth characters 
              */
-            std::string padNumber(int num);
+            void padNumber(int num, char* label) const;
 
         public: 
             /**
@@ -50,7 +77,13 @@ namespace Paintbots {
             void update(Observable* subject) override; 
 
             /**
-             * Displays current state of the game board
+             * Updates only the squares that changed, refreshing everything the first 
+             * time it sees a board 
+             */
+            void update(Observable* subject, const BoardChange& change) override; 
+
+            /**
+             * Displays current state of the game board with a single write 
              */
             void display(); 
     }; 
@@ -29,8 +29,32 @@ GameBoard* PlainDisplayTest::getTestBoard() {
     return GameBoard::getInstance("xyzzy");
 }
 
+// Picks the four characters of a square out of a displayed frame
+std::string PlainDisplayTest::cellOf(const std::string& output, int row, int col) {
+    std::istringstream lines(output);
+    std::string line;
+    for (int i = 0; i <= row + 1; i++) {
+        std::getline(lines, line);
+    }
+    return line.substr(3 + col * 5, 4);
+}
+
 void PlainDisplayTest::setUp() {
     GameBoard::resetInstance();
+
+    // The layout is random, start from an empty board so the tests can place their own
+    GameBoard* board = getTestBoard();
+    for (int i = 1; i <= board->getSize(); ++i) {
+        for (int j = 1; j <= board->getSize(); ++j) {
+            board->getSquare(i, j).setRedRobot(false);
+            board->getSquare(i, j).setBlueRobot(false);
+            board->getSquare(i, j).setType(EMPTY);
+        }
+    }
+    board->getSquare(12, 3).setRedRobot(true);
+    board->getSquare(12, 3).setRobotDirection(NORTH);
+    board->getSquare(4, 12).setBlueRobot(true);
+    board->getSquare(4, 12).setRobotDirection(SOUTH);
 }
 
 void PlainDisplayTest::tearDown() {
@@ -62,7 +86,7 @@ void PlainDisplayTest::testInitialization() {
     assert(newlines == 18); // 17 rows + 1 header row
     
     // Verify initial state (all white squares)
-    assert(output.find("W- ") != std::string::npos);
+    assert(output.find("W--- ") != std::string::npos);
     std::cout << "Initialization test: PASS\n";
 }
 
@@ -76,7 +100,7 @@ void PlainDisplayTest::testWallDisplay() {
     display.display(); 
     std::string output = capture.getOutput();
     
-    assert(output.find("W-X") != std::string::npos);
+    assert(output.find("WWWW") != std::string::npos);
     
     board->removeObserver(&display);
     std::cout << "Wall display test: PASS\n";
@@ -99,8 +123,8 @@ void PlainDisplayTest::testRobotDisplay() {
     std::string output = capture.getOutput();
 
     // Check for robot representations
-    assert(output.find("RR") != std::string::npos); // Red robot
-    assert(output.find("BR") != std::string::npos); // Blue robot
+    assert(output.find("WR--") != std::string::npos); // Red robot
+    assert(output.find("WB--") != std::string::npos); // Blue robot
 
     board->removeObserver(&display);
     std::cout << "Robot display test: PASS\n";
@@ -124,7 +148,7 @@ void PlainDisplayTest::testRockDisplay() {
     std::cerr << "Complete Output:\n" << output << "\n";
 
     // Check for rock representation
-    bool rockFound = output.find("W-R") != std::string::npos;
+    bool rockFound = cellOf(output, 5, 5)[2] == 'X';
     if (!rockFound) {
         std::cerr << "Rock representation not found! Checking for other variations...\n";
         if (output.find("R") != std::string::npos) {
@@ -153,7 +177,7 @@ void PlainDisplayTest::testFogDisplay() {
     std::string output = capture.getOutput();
 
     // Check for fog representation
-    assert(output.find("W-F") != std::string::npos);
+    assert(cellOf(output, 7, 7)[3] == 'X');
 
     board->removeObserver(&display);
     std::cout << "Fog display test: PASS\n";
@@ -233,7 +257,13 @@ void PlainDisplayTest::testObserverUpdate() {
     display.display();
     std::string before = capture1.getOutput();
 
-    board->moveRobot(request);
+    // Turn away from the wall until the robot can move
+    RobotMoveRequest turn;
+    turn.robot = RobotMoveRequest::RED;
+    turn.move = RobotMoveRequest::ROTATERIGHT;
+    for (int i = 0; i < 4 && !board->moveRobot(request); i++) {
+        board->moveRobot(turn);
+    }
 
     OutputCapture capture2;
     display.display();
@@ -362,7 +392,7 @@ void PlainDisplayTest::testComplexBoardState() {
     std::cout << "Full output:\n" << output << "\n";
 
     // Verify rock representation with more detailed debugging
-    bool rockFound = output.find("W-R") != std::string::npos;
+    bool rockFound = cellOf(output, 5, 5)[2] == 'X';
     if (!rockFound) {
         std::cout << "Rock representation not found!\n";
         
@@ -380,11 +410,11 @@ void PlainDisplayTest::testComplexBoardState() {
 
     // Verify all elements are present
     assert(rockFound); // Rock
-    assert(output.find("W-F") != std::string::npos); // Fog
-    assert(output.find("RR") != std::string::npos);  // Red robot
-    assert(output.find("BR") != std::string::npos);  // Blue robot
-    assert(output.find("R-") != std::string::npos);  // Red square
-    assert(output.find("B-") != std::string::npos);  // Blue square
+    assert(cellOf(output, 6, 6)[3] == 'X');  // Fog
+    assert(cellOf(output, 7, 7)[1] == 'R');  // Red robot
+    assert(cellOf(output, 8, 8)[1] == 'B');  // Blue robot
+    assert(cellOf(output, 9, 9)[0] == 'R');  // Red square
+    assert(cellOf(output, 10, 10)[0] == 'B');  // Blue square
 
     board->removeObserver(&display);
     std::cout << "Complex board state test: PASS\n";
@@ -409,6 +439,102 @@ void PlainDisplayTest::testMemoryManagement() {
     std::cout << "Memory management test: PASS\n";
 }
 
+void PlainDisplayTest::testCellFormat() {
+    GameBoard* board = getTestBoard();
+    PlainDisplay display;
+    board->addObserver(&display);
+
+    // Every color with every occupant and feature, facing must not matter
+    const SquareColor colors[] = {WHITE, RED, BLUE};
+    const char colorChars[] = {'W', 'R', 'B'};
+    for (int c = 0; c < 3; c++) {
+        for (int robots = 0; robots < 3; robots++) {
+            for (int type = 0; type < 3; type++) {
+                InternalBoardSquare& square = board->getSquare(3, 3);
+                square.setRedRobot(false);
+                square.setBlueRobot(false);
+                square.setType(EMPTY);
+                square.setType(type == 0 ? EMPTY : (type == 1 ? ROCK : FOG));
+                square.setSquareColor(colors[c]);
+                square.setRedRobot(robots == 1);
+                square.setBlueRobot(robots == 2);
+                square.setRobotDirection(static_cast<Direction>((c + robots + type) % 4));
+                board->notifyObservers();
+
+                OutputCapture capture;
+                display.display();
+                std::string cell = cellOf(capture.getOutput(), 3, 3);
+
+                std::string expected(1, colorChars[c]);
+                expected += robots == 1 ? 'R' : (robots == 2 ? 'B' : '-');
+                expected += type == 1 ? 'X' : '-';
+                expected += type == 2 ? 'X' : '-';
+                assert(cell == expected);
+            }
+        }
+    }
+
+    // Walls override everything else
+    OutputCapture capture;
+    display.display();
+    std::string output = capture.getOutput();
+    assert(cellOf(output, 0, 0) == "WWWW");
+    assert(cellOf(output, 16, 5) == "WWWW");
+
+    InternalBoardSquare& square = board->getSquare(3, 3);
+    square.setType(EMPTY);
+    square.setSquareColor(WHITE);
+    square.setBlueRobot(false);
+    board->notifyObservers();
+
+    board->removeObserver(&display);
+    std::cout << "Cell format test: PASS\n";
+}
+
+void PlainDisplayTest::testIncrementalFrame() {
+    GameBoard* board = getTestBoard();
+    PlainDisplay display;
+    board->addObserver(&display);
+    board->notifyObservers();
+
+    // Moves reach the display as changed squares only
+    RobotMoveRequest request;
+    request.robot = RobotMoveRequest::BLUE;
+    request.move = RobotMoveRequest::FORWARD;
+    for (int i = 0; i < 3; i++) {
+        board->moveRobot(request);
+    }
+    request.move = RobotMoveRequest::ROTATELEFT;
+    board->moveRobot(request);
+    board->setSquareColor(2, 2, RED);
+
+    OutputCapture capture;
+    display.display();
+    std::string incremental = capture.getOutput();
+
+    // A display refreshing everything at once has to print the same frame
+    PlainDisplay fresh;
+    fresh.update(board);
+    OutputCapture freshCapture;
+    fresh.display();
+    assert(freshCapture.getOutput() == incremental);
+
+    // The frame is one header and one line per row, all the same length
+    std::istringstream lines(incremental);
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line)) {
+        if (count > 0) {
+            assert(line.size() == 3 + 17 * 5);
+        }
+        count++;
+    }
+    assert(count == 18);
+
+    board->removeObserver(&display);
+    std::cout << "Incremental frame test: PASS\n";
+}
+
 bool PlainDisplayTest::doTests() {
     bool allTestsPassed = true;
     try {
@@ -428,6 +554,8 @@ bool PlainDisplayTest::doTests() {
         testMultipleUpdates();
         testComplexBoardState();
         testMemoryManagement();
+        testCellFormat();
+        testIncrementalFrame();
         tearDown();
         
     } catch (const std::exception& e) {
@@ -26,6 +26,7 @@ private:
 
     // Helper methods
     GameBoard* getTestBoard();
+    static std::string cellOf(const std::string& output, int row, int col);
     void setUp();
     void tearDown();
 
@@ -41,6 +42,8 @@ private:
     void testMultipleUpdates();
     void testComplexBoardState();
     void testMemoryManagement();
+    void testCellFormat();
+    void testIncrementalFrame();
 
 public:
     // Required by ITest interface
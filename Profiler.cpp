@@ -0,0 +1,132 @@
+#include "Profiler.h"
+
+#ifdef PAINTBOTS_PROFILE
+
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * One profiler per thread, created on first use
+     */
+    Profiler& Profiler::current() {
+        static thread_local Profiler profiler;
+        return profiler;
+    }
+
+    /**
+     * Starts with empty histograms
+     */
+    Profiler::Profiler() {
+        reset();
+    }
+
+    /**
+     * Clears every sample
+     */
+    void Profiler::reset() {
+        std::memset(phases, 0, sizeof(phases));
+    }
+
+    /**
+     * Values below SUB_BUCKETS get a bucket each, above that every power of two is
+     * split into SUB_BUCKETS equal parts
+     */
+    int Profiler::bucketOf(uint64_t nanoseconds) {
+        if (nanoseconds < uint64_t(SUB_BUCKETS)) {
+            return static_cast<int>(nanoseconds);
+        }
+#if defined(__GNUC__) || defined(__clang__)
+        int exponent = 63 - __builtin_clzll(nanoseconds);
+#else
+        int exponent = 0;
+        while (nanoseconds >> (exponent + 1)) {
+            ++exponent;
+        }
+#endif
+        int sub = static_cast<int>((nanoseconds >> (exponent - 3)) & (SUB_BUCKETS - 1));
+        return (exponent - 2) * SUB_BUCKETS + sub;
+    }
+
+    /**
+     * Inverse of bucketOf, the top of the bucket's range
+     */
+    uint64_t Profiler::bucketLimit(int bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        int exponent = bucket / SUB_BUCKETS + 2;
+        uint64_t sub = bucket % SUB_BUCKETS;
+        uint64_t base = (uint64_t(SUB_BUCKETS) + sub) << (exponent - 3);
+        return base + (uint64_t(1) << (exponent - 3)) - 1;
+    }
+
+    /**
+     * Adds a sample
+     */
+    void Profiler::record(Phase phase, uint64_t nanoseconds) {
+        Histogram& histogram = phases[phase];
+        ++histogram.count;
+        histogram.total += nanoseconds;
+        histogram.max = std::max(histogram.max, nanoseconds);
+        ++histogram.buckets[bucketOf(nanoseconds)];
+    }
+
+    /**
+     * Walks the buckets up to the one holding the q-th sample, capped at the real max
+     */
+    uint64_t Profiler::quantile(Phase phase, double q) const {
+        const Histogram& histogram = phases[phase];
+        if (histogram.count == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(q * (histogram.count - 1)) + 1;
+        uint64_t seen = 0;
+        for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+            seen += histogram.buckets[bucket];
+            if (seen >= rank) {
+                return std::min(bucketLimit(bucket), histogram.max);
+            }
+        }
+        return histogram.max;
+    }
+
+    /**
+     * Names of the phases, in enum order
+     */
+    const char* Profiler::phaseName(Phase phase) {
+        static const char* const NAMES[PHASE_COUNT] = {
+            "turn", "scans", "red_agent", "blue_agent", "both_agents", "robot_moves", "move_robot",
+            "paint_blob", "short_scan", "long_scan", "notify", "display"
+        };
+        return NAMES[phase];
+    }
+
+    /**
+     * One entry per phase that has samples, all times in nanoseconds
+     */
+    void Profiler::writeJson(std::ostream& out) const {
+        out << "{\n  \"unit\": \"ns\",\n  \"phases\": {";
+        bool first = true;
+        for (int i = 0; i < PHASE_COUNT; ++i) {
+            Phase phase = static_cast<Phase>(i);
+            const Histogram& histogram = phases[phase];
+            if (histogram.count == 0) {
+                continue;
+            }
+            out << (first ? "\n" : ",\n") << "    \"" << phaseName(phase) << "\": {"
+                << "\"count\": " << histogram.count
+                << ", \"total\": " << histogram.total
+                << ", \"mean\": " << histogram.total / histogram.count
+                << ", \"p50\": " << quantile(phase, 0.5)
+                << ", \"p99\": " << quantile(phase, 0.99)
+                << ", \"max\": " << histogram.max << "}";
+            first = false;
+        }
+        out << "\n  }\n}\n";
+    }
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+/**
+ * Per phase timing of the game loop, built only with -DPAINTBOTS_PROFILE (make PROFILE=1).
+ *
+ * Code marks a phase with PAINTBOTS_PROFILE_SCOPE(Paintbots::Profiler::SOME_PHASE), which
+ * times the rest of the enclosing block on the monotonic clock, or adds a sample timed
+ * elsewhere, e.g. on another thread, with PAINTBOTS_PROFILE_RECORD. Without the flag the
+ * macros expand to nothing and neither the profiler nor its clock calls are compiled.
+ */
+#ifdef PAINTBOTS_PROFILE
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class Profiler
+     * Latency histograms for every phase of a turn
+     *
+     * Each thread records into its own instance, so matches on tournament workers do
+     * not contend. Histograms use log linear buckets, eight per power of two, which keeps
+     * recording allocation free and quantiles within 12.5% of the true value.
+     */
+    class Profiler {
+        public:
+            /**
+             * @enum The timed phases
+             */
+            enum Phase {
+                TURN,           // a whole turn as seen by GameLogic
+                SCANS,          // filling the scans handed to the agents
+                RED_AGENT,      // red nextMove, timed on the thread running it
+                BLUE_AGENT,     // blue nextMove, timed on the thread running it
+                BOTH_AGENTS,    // both nextMove calls when they run concurrently
+                ROBOT_MOVES,    // Match::processRobotMoves
+                MOVE_ROBOT,     // GameBoard::moveRobot
+                PAINT_BLOB,     // GameBoard::paintBlobHit
+                SHORT_SCAN,     // GameBoard::getShortRangeScan
+                LONG_SCAN,      // GameBoard::getLongRangeScan
+                NOTIFY,         // observer updates, e.g. PlainDisplay
+                DISPLAY,        // printing the board
+                PHASE_COUNT
+            };
+
+            /**
+             * Gets the calling thread's profiler
+             */
+            static Profiler& current();
+
+            /**
+             * Creates a profiler with empty histograms
+             */
+            Profiler();
+
+            /**
+             * Empties every histogram
+             */
+            void reset();
+
+            /**
+             * Adds one sample to a phase
+             */
+            void record(Phase phase, uint64_t nanoseconds);
+
+            /**
+             * @return number of samples of a phase
+             */
+            uint64_t count(Phase phase) const {return phases[phase].count;}
+
+            /**
+             * @return approximate quantile of a phase in nanoseconds, q between 0 and 1
+             */
+            uint64_t quantile(Phase phase, double q) const;
+
+            /**
+             * @return slowest sample of a phase in nanoseconds
+             */
+            uint64_t max(Phase phase) const {return phases[phase].max;}
+
+            /**
+             * Writes count, total, mean, p50, p99 and max of every phase as a JSON object
+             */
+            void writeJson(std::ostream& out) const;
+
+            /**
+             * @return name of a phase as used in the JSON summary
+             */
+            static const char* phaseName(Phase phase);
+
+        private:
+            static const int SUB_BUCKETS = 8; // buckets per power of two
+            static const int BUCKETS = 64 * SUB_BUCKETS;
+
+            /**
+             * @struct Samples of one phase
+             */
+            struct Histogram {
+                uint64_t count;
+                uint64_t total;
+                uint64_t max;
+                uint32_t buckets[BUCKETS];
+            };
+
+            Histogram phases[PHASE_COUNT]; // one histogram per phase
+
+            /**
+             * @return bucket a sample falls into
+             */
+            static int bucketOf(uint64_t nanoseconds);
+
+            /**
+             * @return largest value that falls into a bucket
+             */
+            static uint64_t bucketLimit(int bucket);
+    };
+
+    /**
+     * @class ProfileSpan
+     * Times a phase from construction to destruction
+     */
+    class ProfileSpan {
+        public:
+            explicit ProfileSpan(Profiler::Phase phase) :
+                phase(phase),
+                start(std::chrono::steady_clock::now()) {}
+
+            ~ProfileSpan() {
+                std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+                Profiler::current().record(phase,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+
+        private:
+            Profiler::Phase phase; // phase being timed
+            std::chrono::steady_clock::time_point start; // when the span began
+
+            ProfileSpan(const ProfileSpan&) = delete;
+            ProfileSpan& operator = (const ProfileSpan&) = delete;
+    };
+}
+
+#define PAINTBOTS_PROFILE_CONCAT_(a, b) a##b
+#define PAINTBOTS_PROFILE_CONCAT(a, b) PAINTBOTS_PROFILE_CONCAT_(a, b)
+#define PAINTBOTS_PROFILE_SCOPE(phase) \
+    ::Paintbots::ProfileSpan PAINTBOTS_PROFILE_CONCAT(profileSpan, __LINE__)(phase)
+#define PAINTBOTS_PROFILE_RECORD(phase, nanoseconds) ::Paintbots::Profiler::current().record(phase, nanoseconds)
+#define PAINTBOTS_PROFILE_RESET() ::Paintbots::Profiler::current().reset()
+
+#else
+
+#define PAINTBOTS_PROFILE_SCOPE(phase)
+#define PAINTBOTS_PROFILE_RECORD(phase, nanoseconds) ((void)0)
+#define PAINTBOTS_PROFILE_RESET() ((void)0)
+
+#endif
+
+#endif
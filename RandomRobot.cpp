@@ -16,7 +16,12 @@ namespace Paintbots {
         robotColor(RobotMoveRequest::RED), 
         rng(std::time(nullptr)),
         paintBlobsLeft(30),
-        lastMove(RobotMoveRequest::NONE) {}
+        moveCount(0),
+        lastMove(RobotMoveRequest::NONE),
+        myTerritory(0),
+        enemyTerritory(0),
+        territoryKnown(false),
+        territoryAge(0) {}
 
     /**
      * Returns string representing the robot's name 
@@ -61,30 +66,46 @@ namespace Paintbots {
      * - Aggressive mode: tries to face and attack enemy if loosing territory 
      * - Exploratory mode: moves and paints territory randomly when no enemies are in range 
      * - Shooting: Fires paint if the enemy is in range absed on random choices 
+     * 
+     * The territory is counted by a popcount over the paint layers 
      */
-    RobotMoveRequest* RandomRobot::getMove(ExternalBoardSquare** srs, ExternalBoardSquare** lrs) {
-        RobotMoveRequest* request = new RobotMoveRequest();
-        request->robot = robotColor;
-        
+    RobotMoveRequest RandomRobot::nextMove(AgentContext& context) {
+        refreshTerritory(context);
+        return decideMove(context.shortRangeScan());
+    }
+
+    /**
+     * Spends a long range scan on the first move and every TERRITORY_REFRESH moves 
+     * after, keeping the last count in between and once the scans run out 
+     */
+    void RandomRobot::refreshTerritory(AgentContext& context) {
+        if (territoryKnown && ++territoryAge < TERRITORY_REFRESH) {
+            return;
+        }
+        const BitBoard* layers = context.requestLayers();
+        if (!layers) {
+            return;
+        }
+        int red = layers->count(BitBoard::RED_LAYER);
+        int blue = layers->count(BitBoard::BLUE_LAYER);
+        myTerritory = (robotColor == RobotMoveRequest::RED) ? red : blue;
+        enemyTerritory = (robotColor == RobotMoveRequest::RED) ? blue : red;
+        territoryKnown = true;
+        territoryAge = 0;
+    }
+
+    /**
+     * Picks the move from the short range scan and the territory counts 
+     */
+    RobotMoveRequest RandomRobot::decideMove(ExternalBoardSquare** srs) {
+        RobotMoveRequest request = {};
+        request.robot = robotColor;
+
         // Get current state
         Direction currentDir = srs[2][2].robotDirection();
         
-        // Analyze long range scan for strategy
-        int myTerritory = 0, enemyTerritory = 0;
-        for(int i = 0; i < GameBoard::BOARD_SIZE + 2; i++) {
-            for(int j = 0; j < GameBoard::BOARD_SIZE + 2; j++) {
-                if((robotColor == RobotMoveRequest::RED && lrs[i][j].getSquareColor() == RED) ||
-                (robotColor == RobotMoveRequest::BLUE && lrs[i][j].getSquareColor() == BLUE)) {
-                    myTerritory++;
-                } else if((robotColor == RobotMoveRequest::RED && lrs[i][j].getSquareColor() == BLUE) ||
-                        (robotColor == RobotMoveRequest::BLUE && lrs[i][j].getSquareColor() == RED)) {
-                    enemyTerritory++;
-                }
-            }
-        }
-        
-        // If losing, be more aggressive
-        bool aggressive = enemyTerritory > myTerritory;
+        // If losing, be more aggressive, a robot that never counted has no reason to think so
+        bool aggressive = territoryKnown && enemyTerritory > myTerritory;
         
         // Look for enemy in short range
         bool enemyInRange = false;
@@ -112,12 +133,12 @@ namespace Paintbots {
         if(enemyInRange && aggressive) {
             // Try to face enemy for shooting
             if(currentDir != enemyDir) {
-                request->move = (moveCount % 2 == 0) ? 
+                request.move = (moveCount % 2 == 0) ? 
                     RobotMoveRequest::ROTATELEFT : 
                     RobotMoveRequest::ROTATERIGHT;
             } else if(srs[1][2].getSquareType() != WALL && 
                     srs[1][2].getSquareType() != ROCK) {
-                request->move = RobotMoveRequest::FORWARD;
+                request.move = RobotMoveRequest::FORWARD;
             }
         } else {
             // Explore and paint territory
@@ -126,24 +147,24 @@ namespace Paintbots {
             
             if(moveChoice < 5 && srs[1][2].getSquareType() != WALL && 
             srs[1][2].getSquareType() != ROCK) {
-                request->move = RobotMoveRequest::FORWARD;
+                request.move = RobotMoveRequest::FORWARD;
             } else if(moveChoice < 7) {
-                request->move = RobotMoveRequest::ROTATELEFT;
+                request.move = RobotMoveRequest::ROTATELEFT;
             } else if(moveChoice < 9) {
-                request->move = RobotMoveRequest::ROTATERIGHT;
+                request.move = RobotMoveRequest::ROTATERIGHT;
             } else {
-                request->move = RobotMoveRequest::NONE;
+                request.move = RobotMoveRequest::NONE;
             }
         }
 
         // Shoot if we have paint and either:
         // 1. Enemy in range and facing them
         // 2. Random chance when exploring
-        request->shoot = paintBlobsLeft > 0 && 
+        request.shoot = paintBlobsLeft > 0 && 
                         ((enemyInRange && currentDir == enemyDir) ||
                         (!enemyInRange && std::uniform_int_distribution<>(1,5)(rng) == 1));
                         
-        if(request->shoot) paintBlobsLeft--;
+        if(request.shoot) paintBlobsLeft--;
 
         return request;
     }
@@ -154,4 +175,21 @@ namespace Paintbots {
     void RandomRobot::setRobotColor(RobotMoveRequest::RobotColor c) {
         robotColor = c;
     }
-}
\ No newline at end of file
+
+    /**
+     * Reseeds the random number generator, both halves of the seed count 
+     */
+    void RandomRobot::setSeed(uint64_t seed) {
+        std::seed_seq sequence{uint32_t(seed), uint32_t(seed >> 32)};
+        rng.seed(sequence);
+    }
+
+    /**
+     * A new match starts without a territory count 
+     */
+    void RandomRobot::setBoardSize(int size) {
+        (void)size;
+        territoryKnown = false;
+        territoryAge = 0;
+    }
+}
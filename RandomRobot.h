@@ -31,6 +31,16 @@ namespace Paintbots {
              */
             RobotMoveRequest::RobotMove getRandomMove(ExternalBoardSquare** srs);
 
+            /**
+             * Picks the move from the short range scan and the last territory count 
+             */
+            RobotMoveRequest decideMove(ExternalBoardSquare** srs);
+
+            /**
+             * Recounts the territory from the bitboard layers when the count is due 
+             */
+            void refreshTerritory(AgentContext& context);
+
             /**
              * The number of paint blobs left for shooting 
              */
@@ -51,6 +61,28 @@ namespace Paintbots {
              */
             Direction currentDirection;  
 
+            /**
+             * Moves between two territory counts, so the LONG_RANGE_LIMIT scans last 
+             * through the match 
+             */
+            static const int TERRITORY_REFRESH = 50;
+
+            /**
+             * Squares in the robot's and in the enemy's color at the last count 
+             */
+            int myTerritory;  
+            int enemyTerritory;  
+
+            /**
+             * Whether the territory was counted at all in this match 
+             */
+            bool territoryKnown;  
+
+            /**
+             * Moves since the territory was last counted 
+             */
+            int territoryAge;  
+
         public:
 
             /**
@@ -69,15 +101,26 @@ namespace Paintbots {
             std::string getRobotCreator() override;
 
             /**
-             * Determines robot's next move based on game board state 
+             * Determines robot's next move based on game board state, reading the 
+             * territory from the bitboard layers every TERRITORY_REFRESH moves, so the 
+             * long range scan is never built 
              */
-            RobotMoveRequest* getMove(ExternalBoardSquare** srs, 
-                                    ExternalBoardSquare** lrs) override;
+            RobotMoveRequest nextMove(AgentContext& context) override;
 
             /**
              * Assigns the robot's color 
              */
             void setRobotColor(RobotMoveRequest::RobotColor c) override;
+
+            /**
+             * Reseeds the random number generator from the match seed 
+             */
+            void setSeed(uint64_t seed) override;
+
+            /**
+             * Forgets the territory of the previous match 
+             */
+            void setBoardSize(int size) override;
     };
 }
 
@@ -0,0 +1,354 @@
+#include "Replay.h"
+#include <iterator>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    namespace {
+        const char MAGIC[4] = {'P', 'B', 'R', 'P'};
+        const uint8_t KEYFRAME_TAG = 'K';
+        const uint8_t TURN_TAG = 'T';
+        const uint8_t END_TAG = 'E';
+
+        /**
+         * Appends a LEB128 varint, seven bits per byte with the high bit set on all but the last
+         */
+        void appendVarint(std::vector<uint8_t>& out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        /**
+         * Packs both moves and the hits of a turn into one byte
+         */
+        uint8_t packMoves(const RobotMoveRequest& redMove, const RobotMoveRequest& blueMove,
+                          bool redHit, bool blueHit) {
+            return static_cast<uint8_t>((redMove.move & 3) |
+                                        (redMove.shoot ? 1 << 2 : 0) |
+                                        ((blueMove.move & 3) << 3) |
+                                        (blueMove.shoot ? 1 << 5 : 0) |
+                                        (redHit ? 1 << 6 : 0) |
+                                        (blueHit ? 1 << 7 : 0));
+        }
+
+        /**
+         * Builds a move request for a robot that did nothing
+         */
+        RobotMoveRequest noMove(RobotMoveRequest::RobotColor robot) {
+            RobotMoveRequest request;
+            request.robot = robot;
+            request.move = RobotMoveRequest::NONE;
+            request.shoot = false;
+            return request;
+        }
+    }
+
+    /**
+     * Writes the playable squares of the frame into the board, the walls around them
+     * are the same on every board of a size
+     */
+    void ReplayFrame::applyTo(GameBoard& board) const {
+        if (board.getSize() != size) {
+            throw std::invalid_argument("Replay frame does not fit the board size");
+        }
+        const uint8_t* packed = squares.data();
+        for (int row = 1; row <= size; ++row) {
+            for (int col = 1; col <= size; ++col) {
+                board.getSquare(row, col).setPackedState(*packed++);
+            }
+        }
+    }
+
+    /**
+     * Sets up a writer, nothing is written before begin
+     */
+    ReplayWriter::ReplayWriter(std::ostream& out, int keyframeInterval) :
+        out(out),
+        keyframeInterval(keyframeInterval),
+        turn(0) {
+        if (keyframeInterval <= 0) {
+            throw std::invalid_argument("Keyframe interval must be positive");
+        }
+    }
+
+    /**
+     * Copies the packed squares of the board, sizing the snapshot on the first call
+     */
+    void ReplayWriter::snapshot(const GameBoard& board) {
+        int size = board.getSize();
+        previous.resize(size_t(size) * size);
+        record.reserve(2 * previous.size());
+        uint8_t* packed = previous.data();
+        for (int row = 1; row <= size; ++row) {
+            for (int col = 1; col <= size; ++col) {
+                *packed++ = board.getSquare(row, col).packedState();
+            }
+        }
+    }
+
+    /**
+     * Writes the last snapshot as a keyframe
+     */
+    void ReplayWriter::writeKeyframe() {
+        record.clear();
+        record.push_back(KEYFRAME_TAG);
+        appendVarint(record, turn);
+        record.insert(record.end(), previous.begin(), previous.end());
+        out.write(reinterpret_cast<const char*>(record.data()), record.size());
+    }
+
+    /**
+     * Writes the header followed by a keyframe of the starting layout
+     */
+    void ReplayWriter::begin(const GameBoard& board) {
+        record.clear();
+        record.insert(record.end(), MAGIC, MAGIC + sizeof(MAGIC));
+        record.push_back(1); // version
+        appendVarint(record, board.getSize());
+        appendVarint(record, keyframeInterval);
+        uint64_t seed = board.getSeed();
+        for (int i = 0; i < 8; ++i) {
+            record.push_back(static_cast<uint8_t>(seed >> (8 * i)));
+        }
+        out.write(reinterpret_cast<const char*>(record.data()), record.size());
+
+        turn = 0;
+        snapshot(board);
+        writeKeyframe();
+    }
+
+    /**
+     * Diffs the board against the previous record, then appends a keyframe if one is due
+     */
+    void ReplayWriter::recordTurn(const GameBoard& board, const RobotMoveRequest& redMove,
+                                  const RobotMoveRequest& blueMove, bool redHit, bool blueHit) {
+        ++turn;
+        record.clear();
+        record.push_back(TURN_TAG);
+        record.push_back(packMoves(redMove, blueMove, redHit, blueHit));
+
+        int size = board.getSize();
+        if (previous.size() != size_t(size) * size) {
+            throw std::invalid_argument("Board size changed during the replay");
+        }
+        current.resize(previous.size());
+        uint8_t* packed = current.data();
+        int changes = 0;
+        for (int row = 1; row <= size; ++row) {
+            for (int col = 1; col <= size; ++col) {
+                *packed = board.getSquare(row, col).packedState();
+                changes += *packed != previous[packed - current.data()];
+                ++packed;
+            }
+        }
+
+        appendVarint(record, changes);
+        int last = -1;
+        for (int index = 0; index < int(current.size()); ++index) {
+            if (current[index] != previous[index]) {
+                appendVarint(record, index - last - 1);
+                record.push_back(current[index]);
+                previous[index] = current[index];
+                last = index;
+            }
+        }
+        out.write(reinterpret_cast<const char*>(record.data()), record.size());
+
+        if (turn % keyframeInterval == 0) {
+            writeKeyframe();
+        }
+    }
+
+    /**
+     * Appends the result, after which the log is complete
+     */
+    void ReplayWriter::end(const MatchResult& result) {
+        record.clear();
+        record.push_back(END_TAG);
+        appendVarint(record, result.turns);
+        record.push_back(static_cast<uint8_t>(result.endReason));
+        appendVarint(record, result.redScore);
+        appendVarint(record, result.blueScore);
+        out.write(reinterpret_cast<const char*>(record.data()), record.size());
+        out.flush();
+    }
+
+    /**
+     * Reads the whole log and indexes its keyframes
+     */
+    ReplayReader::ReplayReader(std::istream& in) :
+        data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()),
+        seed(0),
+        boardSize(0),
+        squareCount(0),
+        turnCount(0),
+        complete(false) {
+        result.redScore = 0;
+        result.blueScore = 0;
+        result.turns = 0;
+        result.endReason = MatchResult::MOVE_LIMIT;
+        result.redTimeouts = 0;
+        result.blueTimeouts = 0;
+
+        if (data.size() < sizeof(MAGIC) || !std::equal(MAGIC, MAGIC + sizeof(MAGIC), data.begin())) {
+            throw std::runtime_error("Not a paintbots replay");
+        }
+        size_t offset = sizeof(MAGIC);
+        if (readByte(offset) != VERSION) {
+            throw std::runtime_error("Unsupported replay version");
+        }
+        uint64_t size = readVarint(offset);
+        if (size < 1 || size > uint64_t(GameBoard::MAX_SIZE)) {
+            throw std::runtime_error("Replay has an unsupported board size");
+        }
+        boardSize = static_cast<int>(size);
+        squareCount = size_t(boardSize) * boardSize;
+        readVarint(offset); // keyframe interval, the index below does not need it
+        for (int i = 0; i < 8; ++i) {
+            seed |= uint64_t(readByte(offset)) << (8 * i);
+        }
+        result.seed = seed;
+
+        ReplayFrame scratch;
+        scratch.size = boardSize;
+        scratch.squares.resize(squareCount);
+        while (offset < data.size() && !complete) {
+            uint8_t tag = readByte(offset);
+            if (tag == KEYFRAME_TAG) {
+                Keyframe keyframe;
+                keyframe.turn = static_cast<int>(readVarint(offset));
+                keyframe.offset = offset;
+                if (keyframe.turn != turnCount || data.size() - offset < squareCount) {
+                    throw std::runtime_error("Corrupt replay keyframe");
+                }
+                keyframes.push_back(keyframe);
+                offset += squareCount;
+            } else if (tag == TURN_TAG) {
+                offset = readTurn(offset, scratch);
+                ++turnCount;
+            } else if (tag == END_TAG) {
+                result.turns = static_cast<int>(readVarint(offset));
+                result.endReason = static_cast<MatchResult::EndReason>(readByte(offset));
+                result.redScore = static_cast<int>(readVarint(offset));
+                result.blueScore = static_cast<int>(readVarint(offset));
+                complete = true;
+            } else {
+                throw std::runtime_error("Unknown replay record");
+            }
+        }
+
+        if (keyframes.empty() || keyframes.front().turn != 0) {
+            throw std::runtime_error("Replay has no starting layout");
+        }
+    }
+
+    /**
+     * Starts from the last keyframe before the turn, so the moves of the turn itself
+     * are decoded too, and steps forward from there
+     */
+    ReplayCursor ReplayReader::seek(int turn) const {
+        if (turn < 0 || turn > turnCount) {
+            throw std::out_of_range("Turn " + std::to_string(turn) + " is not in the replay");
+        }
+
+        size_t k = keyframes.size() - 1;
+        while (keyframes[k].turn >= turn && k > 0) {
+            --k;
+        }
+        const Keyframe& keyframe = keyframes[k];
+
+        ReplayCursor cursor(this, keyframe.offset + squareCount);
+        ReplayFrame& frame = cursor.current;
+        frame.turn = keyframe.turn;
+        frame.size = boardSize;
+        frame.squares.assign(data.begin() + keyframe.offset, data.begin() + keyframe.offset + squareCount);
+        frame.redMove = noMove(RobotMoveRequest::RED);
+        frame.blueMove = noMove(RobotMoveRequest::BLUE);
+        frame.redHit = false;
+        frame.blueHit = false;
+
+        while (frame.turn < turn) {
+            cursor.next();
+        }
+        return cursor;
+    }
+
+    /**
+     * Applies one turn record on top of the frame
+     */
+    size_t ReplayReader::readTurn(size_t offset, ReplayFrame& frame) const {
+        uint8_t moves = readByte(offset);
+        frame.redMove.robot = RobotMoveRequest::RED;
+        frame.redMove.move = static_cast<RobotMoveRequest::RobotMove>(moves & 3);
+        frame.redMove.shoot = (moves >> 2) & 1;
+        frame.blueMove.robot = RobotMoveRequest::BLUE;
+        frame.blueMove.move = static_cast<RobotMoveRequest::RobotMove>((moves >> 3) & 3);
+        frame.blueMove.shoot = (moves >> 5) & 1;
+        frame.redHit = (moves >> 6) & 1;
+        frame.blueHit = (moves >> 7) & 1;
+
+        uint64_t changes = readVarint(offset);
+        uint8_t* squares = frame.squares.data();
+        uint64_t index = uint64_t(-1);
+        for (uint64_t i = 0; i < changes; ++i) {
+            index += readVarint(offset) + 1;
+            if (index >= squareCount) {
+                throw std::runtime_error("Corrupt replay turn");
+            }
+            squares[index] = readByte(offset);
+        }
+        ++frame.turn;
+        return offset;
+    }
+
+    /**
+     * Decodes a LEB128 varint
+     */
+    uint64_t ReplayReader::readVarint(size_t& offset) const {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = readByte(offset);
+            value |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Corrupt replay varint");
+    }
+
+    /**
+     * Reads one byte of the log
+     */
+    uint8_t ReplayReader::readByte(size_t& offset) const {
+        if (offset >= data.size()) {
+            throw std::runtime_error("Truncated replay");
+        }
+        return data[offset++];
+    }
+
+    /**
+     * Decodes the next turn record, skipping the keyframe that may follow a turn
+     */
+    bool ReplayCursor::next() {
+        while (offset < reader->data.size()) {
+            size_t start = offset;
+            uint8_t tag = reader->readByte(offset);
+            if (tag == KEYFRAME_TAG) {
+                reader->readVarint(offset);
+                offset += reader->squareCount;
+            } else if (tag == TURN_TAG) {
+                offset = reader->readTurn(offset, current);
+                return true;
+            } else {
+                offset = start; // the end record, stay on the last turn
+                return false;
+            }
+        }
+        return false;
+    }
+}
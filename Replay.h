@@ -0,0 +1,215 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "GameBoard.h"
+#include "Match.h"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @struct The board and the moves of one turn of a recorded match
+     */
+    struct ReplayFrame {
+        int turn; // 0 is the starting layout
+        int size; // playable rows and columns
+        std::vector<uint8_t> squares; // packed state of the playable squares, row major
+        RobotMoveRequest redMove; // moves that led to this frame, NONE on turn 0
+        RobotMoveRequest blueMove;
+        bool redHit; // red hit blue this turn
+        bool blueHit; // blue hit red this turn
+
+        /**
+         * Gets the packed state of a playable square, rows and columns counted from 0
+         */
+        uint8_t square(int row, int col) const {return squares[size_t(row) * size + col];}
+
+        /**
+         * Copies the squares of the frame onto a board, e.g. to display it
+         * @throws std::invalid_argument if the board has a different size
+         */
+        void applyTo(GameBoard& board) const;
+    };
+
+    /**
+     * @class ReplayWriter
+     * Appends a match to a binary replay log as it is played
+     *
+     * Layout, all integers little endian or LEB128 varints:
+     *   header    "PBRP", version byte, board size varint, keyframe interval varint, seed u64
+     *   keyframe  'K', turn varint, one packed byte per playable square, row major
+     *   turn      'T', move byte, change count varint, then per changed square the
+     *             varint distance to the previous change and the new packed byte
+     *   end       'E', turns varint, end reason byte, red and blue score varints
+     * The move byte holds red move (bits 0-1), red shot (2), blue move (3-4), blue
+     * shot (5), red hit (6) and blue hit (7). A typical turn costs under ten bytes, and
+     * a keyframe every few turns lets a reader seek without replaying the whole match.
+     */
+    class ReplayWriter {
+        public:
+            static const int DEFAULT_KEYFRAME_INTERVAL = 100; // turns between keyframes
+
+            /**
+             * Writes to a stream opened in binary mode, which must outlive the writer
+             */
+            explicit ReplayWriter(std::ostream& out, int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+
+            /**
+             * Writes the header and the starting layout
+             */
+            void begin(const GameBoard& board);
+
+            /**
+             * Appends the squares changed by a turn together with the moves that caused it
+             */
+            void recordTurn(const GameBoard& board, const RobotMoveRequest& redMove,
+                            const RobotMoveRequest& blueMove, bool redHit, bool blueHit);
+
+            /**
+             * Appends the final result and flushes the stream
+             */
+            void end(const MatchResult& result);
+
+        private:
+            std::ostream& out; // the log
+            int keyframeInterval; // turns between keyframes
+            int turn; // turns recorded so far
+            std::vector<uint8_t> previous; // squares at the last record, row major
+            std::vector<uint8_t> current; // squares of the turn being recorded, reused between turns
+            std::vector<uint8_t> record; // record being assembled, reused between turns
+
+            /**
+             * Copies the packed squares of the board into previous
+             */
+            void snapshot(const GameBoard& board);
+
+            /**
+             * Writes the snapshot as a keyframe for the current turn
+             */
+            void writeKeyframe();
+
+            ReplayWriter(const ReplayWriter&) = delete;
+            ReplayWriter& operator = (const ReplayWriter&) = delete;
+    };
+
+    class ReplayReader;
+
+    /**
+     * @class ReplayCursor
+     * Position in a replay, steps forward one turn at a time
+     */
+    class ReplayCursor {
+        public:
+            /**
+             * Gets the frame the cursor is on
+             */
+            const ReplayFrame& frame() const {return current;}
+
+            /**
+             * Moves to the next turn
+             * @return false if the cursor was on the last turn
+             */
+            bool next();
+
+        private:
+            friend class ReplayReader;
+            const ReplayReader* reader; // replay being read
+            size_t offset; // start of the next record
+            ReplayFrame current; // decoded state
+
+            ReplayCursor(const ReplayReader* reader, size_t offset) : reader(reader), offset(offset) {}
+    };
+
+    /**
+     * @class ReplayReader
+     * Loads a replay log and seeks to any of its turns
+     *
+     * The log is read into memory and indexed once, seeking then starts from the
+     * nearest keyframe at or before the wanted turn.
+     * @throws std::runtime_error if the log is truncated or not a replay
+     */
+    class ReplayReader {
+        public:
+            /**
+             * Reads a replay from a stream opened in binary mode
+             */
+            explicit ReplayReader(std::istream& in);
+
+            /**
+             * @return seed of the recorded match
+             */
+            uint64_t getSeed() const {return seed;}
+
+            /**
+             * @return playable rows and columns of the recorded board
+             */
+            int getBoardSize() const {return boardSize;}
+
+            /**
+             * @return number of turns recorded
+             */
+            int getTurnCount() const {return turnCount;}
+
+            /**
+             * @return true if the log ends with the match result
+             */
+            bool isComplete() const {return complete;}
+
+            /**
+             * Gets the recorded result, turns and scores are only set once complete
+             */
+            const MatchResult& getResult() const {return result;}
+
+            /**
+             * Positions a cursor on a turn
+             * @throws std::out_of_range if the turn was not recorded
+             */
+            ReplayCursor seek(int turn) const;
+
+        private:
+            friend class ReplayCursor;
+            static const uint8_t VERSION = 1;
+
+            /**
+             * @struct Where a keyframe lies in the log
+             */
+            struct Keyframe {
+                int turn;
+                size_t offset; // start of the keyframe's squares
+            };
+
+            std::vector<uint8_t> data; // the whole log
+            uint64_t seed; // seed of the recorded match
+            int boardSize; // playable rows and columns
+            size_t squareCount; // bytes per keyframe
+            int turnCount; // number of turn records
+            bool complete; // the end record was found
+            MatchResult result; // the end record
+            std::vector<Keyframe> keyframes; // every keyframe, in turn order
+
+            /**
+             * Decodes the turn record at offset into frame
+             * @return offset of the record after it
+             */
+            size_t readTurn(size_t offset, ReplayFrame& frame) const;
+
+            /**
+             * Reads a varint, moving offset past it
+             */
+            uint64_t readVarint(size_t& offset) const;
+
+            /**
+             * Reads one byte, moving offset past it
+             */
+            uint8_t readByte(size_t& offset) const;
+    };
+}
+
+#endif
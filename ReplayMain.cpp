@@ -0,0 +1,125 @@
+// ReplayMain.cpp
+#include "Replay.h"
+#include "PlainDisplay.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+    /**
+     * Prints command line usage
+     */
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " <replay_file> [--turn=N] [--turns=K]\n"
+                  << "Shows the board of a recorded match at turn N (default: the last turn)\n"
+                  << "and of the K - 1 turns after it (default K: 1).\n";
+    }
+
+    /**
+     * Parses the value of a --name=value option, returns false if arg is not that option
+     */
+    bool parseOption(const std::string& arg, const std::string& name, int& value) {
+        std::string prefix = "--" + name + "=";
+        if (arg.compare(0, prefix.size(), prefix) != 0) {
+            return false;
+        }
+        value = std::stoi(arg.substr(prefix.size()));
+        if (value < 0) {
+            throw std::invalid_argument("--" + name + " must not be negative");
+        }
+        return true;
+    }
+
+    /**
+     * Describes what a robot did during a turn
+     */
+    std::string describeMove(const Paintbots::RobotMoveRequest& request) {
+        static const char* const MOVES[] = {"rotate left", "rotate right", "forward", "none"};
+        return std::string(MOVES[request.move]) + (request.shoot ? ", shoots" : "");
+    }
+
+    /**
+     * Names the reason a match ended
+     */
+    const char* describeEnd(Paintbots::MatchResult::EndReason reason) {
+        switch (reason) {
+            case Paintbots::MatchResult::INVALID_MOVE: return "invalid move";
+            case Paintbots::MatchResult::COLLISION: return "collision";
+            default: return "move limit";
+        }
+    }
+}
+
+// Main function
+int main(int argc, char* argv[]) {
+    using namespace Paintbots;
+
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        int turn = -1;
+        int turns = 1;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (!parseOption(arg, "turn", turn) && !parseOption(arg, "turns", turns)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+
+        std::ifstream in(argv[1], std::ios::binary);
+        if (!in.is_open()) {
+            throw std::runtime_error("Could not open replay file: " + std::string(argv[1]));
+        }
+        ReplayReader replay(in);
+
+        std::cout << "Seed " << replay.getSeed() << ", " << replay.getTurnCount() << " turns";
+        if (replay.isComplete()) {
+            const MatchResult& result = replay.getResult();
+            std::cout << ", ended by " << describeEnd(result.endReason) << ", red "
+                      << result.redScore << " blue " << result.blueScore;
+        } else {
+            std::cout << ", incomplete";
+        }
+        std::cout << "\n";
+
+        if (turn < 0) {
+            turn = replay.getTurnCount();
+        }
+        ReplayCursor cursor = replay.seek(turn);
+        Config config;
+        config.setBoardSize(replay.getBoardSize());
+        GameBoard board(config);
+        PlainDisplay display;
+        for (int shown = 0; shown < turns; ++shown) {
+            const ReplayFrame& frame = cursor.frame();
+            std::cout << "\nTurn " << frame.turn << ": red " << describeMove(frame.redMove)
+                      << "; blue " << describeMove(frame.blueMove) << "\n";
+            if (frame.redHit) {
+                std::cout << "Red robot's paint blob hit the blue robot!\n";
+            }
+            if (frame.blueHit) {
+                std::cout << "Blue robot's paint blob hit the red robot!\n";
+            }
+            frame.applyTo(board);
+            display.update(&board);
+            display.display();
+
+            if (!cursor.next()) {
+                break;
+            }
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Replay error: " << e.what() << std::endl;
+        return 1;
+    }
+}
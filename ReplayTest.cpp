@@ -0,0 +1,230 @@
+#include "ReplayTest.h"
+#include "Replay.h"
+#include "Match.h"
+#include "LazyRobot.h"
+#include "RandomRobot.h"
+#include "AntiRandom.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    namespace {
+
+        /**
+         * Asserts that a frame holds the playable squares of a board
+         */
+        void assertFrameMatches(const ReplayFrame& frame, const GameBoard& board) {
+            assert(frame.size == board.getSize());
+            for (int row = 0; row < frame.size; ++row) {
+                for (int col = 0; col < frame.size; ++col) {
+                    assert(frame.square(row, col) == board.getSquare(row + 1, col + 1).packedState());
+                }
+            }
+        }
+
+        /**
+         * Builds a seeded board
+         */
+        GameBoard seededBoard(uint64_t seed) {
+            Config config;
+            config.setSeed(seed);
+            return GameBoard(config);
+        }
+    }
+
+    /**
+     * @test Testing that seeking to any turn rebuilds the board as it was played
+     */
+    void ReplayTest::testRoundTrip() {
+        GameBoard board = seededBoard(77);
+        RandomRobot red;
+        AntiRandom blue;
+        red.setRobotColor(RobotMoveRequest::RED);
+        blue.setRobotColor(RobotMoveRequest::BLUE);
+
+        std::stringstream log;
+        ReplayWriter writer(log, 7);
+        Match match(board, &red, &blue);
+        match.setRecorder(&writer);
+
+        std::vector<GameBoard> played(1, board);
+        while (match.playTurn()) {
+            played.push_back(board);
+        }
+        played.push_back(board);
+
+        ReplayReader replay(log);
+        MatchResult result = match.getResult();
+        assert(replay.isComplete());
+        assert(replay.getSeed() == 77);
+        assert(replay.getTurnCount() == result.turns);
+        assert(replay.getResult().redScore == result.redScore);
+        assert(replay.getResult().blueScore == result.blueScore);
+        assert(replay.getResult().endReason == result.endReason);
+
+        for (int turn = 0; turn <= replay.getTurnCount(); ++turn) {
+            ReplayCursor cursor = replay.seek(turn);
+            assert(cursor.frame().turn == turn);
+            assertFrameMatches(cursor.frame(), played[turn]);
+        }
+
+        ReplayCursor cursor = replay.seek(0);
+        int turns = 0;
+        while (cursor.next()) {
+            ++turns;
+            assert(cursor.frame().turn == turns);
+            assertFrameMatches(cursor.frame(), played[turns]);
+        }
+        assert(turns == replay.getTurnCount());
+
+        try {
+            replay.seek(replay.getTurnCount() + 1);
+            assert(false && "Should throw exception for a turn past the end");
+        } catch (const std::out_of_range&) {
+        }
+        std::cout << "Replay round trip test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a full length match costs a few bytes per turn
+     */
+    void ReplayTest::testCompactLog() {
+        GameBoard board = seededBoard(5);
+        LazyRobot red;
+        LazyRobot blue;
+        red.setRobotColor(RobotMoveRequest::RED);
+        blue.setRobotColor(RobotMoveRequest::BLUE);
+
+        std::stringstream log;
+        ReplayWriter writer(log);
+        Match match(board, &red, &blue);
+        match.setRecorder(&writer);
+        MatchResult result = match.play();
+
+        int keyframes = result.turns / ReplayWriter::DEFAULT_KEYFRAME_INTERVAL + 1;
+        size_t keyframeBytes = keyframes * (GameBoard::BOARD_SIZE * GameBoard::BOARD_SIZE + 3);
+        assert(log.str().size() <= keyframeBytes + 16 * result.turns + 64);
+        std::cout << "Compact replay test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a log cut off after a turn still replays up to that turn
+     */
+    void ReplayTest::testIncompleteLog() {
+        GameBoard board = seededBoard(9);
+        RandomRobot red;
+        RandomRobot blue;
+        red.setRobotColor(RobotMoveRequest::RED);
+        blue.setRobotColor(RobotMoveRequest::BLUE);
+
+        std::stringstream log;
+        ReplayWriter writer(log);
+        Match match(board, &red, &blue);
+        match.setRecorder(&writer);
+        match.playTurn();
+
+        ReplayReader replay(log);
+        assert(!replay.isComplete());
+        assert(replay.getTurnCount() == 1);
+        assertFrameMatches(replay.seek(1).frame(), board);
+        std::cout << "Incomplete replay test: PASS\n";
+    }
+
+    /**
+     * @test Testing that foreign and truncated logs are refused
+     */
+    void ReplayTest::testRejectsCorruptLog() {
+        std::stringstream foreign("not a replay at all");
+        try {
+            ReplayReader replay(foreign);
+            assert(false && "Should throw exception for a foreign file");
+        } catch (const std::runtime_error&) {
+        }
+
+        GameBoard board = seededBoard(11);
+        std::stringstream log;
+        ReplayWriter writer(log);
+        writer.begin(board);
+        std::string bytes = log.str();
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 10));
+        try {
+            ReplayReader replay(truncated);
+            assert(false && "Should throw exception for a truncated keyframe");
+        } catch (const std::runtime_error&) {
+        }
+        std::cout << "Corrupt replay test: PASS\n";
+    }
+
+    /**
+     * @test Testing that the board size travels with the log, also past one varint byte
+     */
+    void ReplayTest::testBoardSize() {
+        Config config;
+        config.setSeed(3);
+        config.setBoardSize(140);
+        GameBoard board(config);
+        RandomRobot red;
+        RandomRobot blue;
+        red.setRobotColor(RobotMoveRequest::RED);
+        blue.setRobotColor(RobotMoveRequest::BLUE);
+
+        std::stringstream log;
+        ReplayWriter writer(log, 4);
+        Match match(board, &red, &blue);
+        match.setRecorder(&writer);
+        std::vector<GameBoard> played(1, board);
+        for (int turn = 0; turn < 10 && match.playTurn(); ++turn) {
+            played.push_back(board);
+        }
+
+        ReplayReader replay(log);
+        assert(replay.getBoardSize() == 140);
+        assert(!replay.isComplete());
+        for (int turn = 0; turn <= replay.getTurnCount(); ++turn) {
+            assertFrameMatches(replay.seek(turn).frame(), played[turn]);
+        }
+
+        GameBoard target(config);
+        replay.seek(replay.getTurnCount()).frame().applyTo(target);
+        GameBoard small;
+        try {
+            replay.seek(0).frame().applyTo(small);
+            assert(false && "Should throw exception for a board of another size");
+        } catch (const std::invalid_argument&) {
+        }
+        std::cout << "Replay board size test: PASS\n";
+    }
+
+    bool ReplayTest::doTests() {
+        bool allTestsPassed = true;
+        try {
+            std::cout << "-------------------------\n";
+            std::cout << "Replay unit tests\n";
+            std::cout << "-------------------------\n";
+
+            testRoundTrip();
+            testCompactLog();
+            testIncompleteLog();
+            testRejectsCorruptLog();
+            testBoardSize();
+
+        } catch (const std::exception& e) {
+            std::cout << "Test failed with exception: " << e.what() << std::endl;
+            allTestsPassed = false;
+        }
+
+        return allTestsPassed;
+    }
+}
+
+// Main function
+int main() {
+    Paintbots::ReplayTest tester;
+    return tester.doTests() ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+#ifndef REPLAY_TEST_H
+#define REPLAY_TEST_H
+
+#include "ITest.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+    class ReplayTest : public ITest {
+        private:
+            /**
+             * Tests that every recorded turn can be sought and matches the played board
+             */
+            void testRoundTrip();
+
+            /**
+             * Tests that a full match stays within a few bytes per turn
+             */
+            void testCompactLog();
+
+            /**
+             * Tests that a log without its end record still replays
+             */
+            void testIncompleteLog();
+
+            /**
+             * Tests that logs which are not replays or cut short are rejected
+             */
+            void testRejectsCorruptLog();
+
+            /**
+             * Tests that a board of another size is recorded and replayed at its size
+             */
+            void testBoardSize();
+
+        public:
+            bool doTests() override;
+    };
+}
+
+#endif
@@ -1,5 +1,4 @@
 #include "Robot.h"
-#include <iostream>
 #include <cstring>  
 #include <stdexcept>  
 #include <algorithm> 
@@ -12,9 +11,7 @@ namespace Paintbots {
     Robot::Robot() : 
         strategy(nullptr),
         robotColor(RobotMoveRequest::RED)
-    {
-        std::cout << "Creating new Robot with null strategy" << std::endl;
-    }
+    {}
 
     /**
      * Specifies whether the robot belongs to red or blue "team"
@@ -1,5 +1,4 @@
 #include "RobotAgentRoster.h"
-#include <iostream>
 #include <cstring>  
 #include <stdexcept>  
 #include <algorithm> 
@@ -12,7 +11,6 @@ namespace Paintbots {
      */
     RobotAgentRoster& RobotAgentRoster::getInstance() {
         if (instance == nullptr) {
-            std::cout << "Creating new RobotAgentRoster instance" << std::endl;
             instance = new RobotAgentRoster();
         }
         return *instance;
@@ -24,12 +22,20 @@ namespace Paintbots {
      */
 
     void RobotAgentRoster::add(IRobotAgent* agent) {
+        add(agent, nullptr);
+    }
+
+    /**
+     * @brief Add a robot agent to the roster along with a factory for it
+     * @param agent Pointer to the IRobotAgent to be added
+     * @param factory Function creating new instances of the agent, may be nullptr
+     */
+    void RobotAgentRoster::add(IRobotAgent* agent, AgentFactory factory) {
         if (agent == nullptr) {
             throw std::invalid_argument("Cannot add null robot agent");
         }
-        std::cout << "Adding robot: " << agent->getRobotName() << std::endl;
         agents.push_back(agent);
-        std::cout << "New roster size: " << agents.size() << std::endl;
+        factories.push_back(factory);
     }
 
     /**
@@ -60,6 +66,24 @@ namespace Paintbots {
         throw std::runtime_error("No robot agent found with name: " + name);
     }
 
+    /**
+     * @brief Create a new instance of a robot agent by name
+     * @param name Name of the robot agent
+     * @return Newly allocated IRobotAgent owned by the caller
+     * @throws std::runtime_error if the agent is unknown or has no factory
+     */
+    IRobotAgent* RobotAgentRoster::spawn(const std::string& name) const {
+        for (size_t i = 0; i < agents.size(); ++i) {
+            if (agents[i]->getRobotName() == name) {
+                if (factories[i] == nullptr) {
+                    throw std::runtime_error("Robot agent cannot be spawned: " + name);
+                }
+                return factories[i]();
+            }
+        }
+        throw std::runtime_error("No robot agent found with name: " + name);
+    }
+
     /**
      * @brief Get the number of agents in the roster
      * @return Size of the agents vector
@@ -76,6 +100,7 @@ namespace Paintbots {
             delete agent;
         }
         agents.clear();
+        factories.clear();
     }
 
     /**
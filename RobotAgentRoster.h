@@ -14,6 +14,21 @@
  */
 namespace Paintbots {
     class RobotAgentRoster {
+        public:
+
+            /**
+             * Function that creates a fresh, caller-owned instance of an agent
+             */
+            typedef IRobotAgent* (*AgentFactory)();
+
+            /**
+             * Factory for agents that can be default constructed
+             */
+            template<typename T>
+            static IRobotAgent* createAgent() {
+                return new T();
+            }
+
         private:
 
             /**
@@ -25,6 +40,11 @@ namespace Paintbots {
              * Vector containing pointers to all registered IRobotAgent instances 
              */
             std::vector<IRobotAgent*> agents;
+
+            /**
+             * Factories matching the agents vector, nullptr for agents added without one
+             */
+            std::vector<AgentFactory> factories;
             
             // Private constructor and deleted copy operations
             RobotAgentRoster() = default;
@@ -43,6 +63,25 @@ namespace Paintbots {
              */
             void add(IRobotAgent* agent);
 
+            /**
+             * Adds new robot agent to the roster along with a factory for creating more of it
+             */
+            void add(IRobotAgent* agent, AgentFactory factory);
+
+            /**
+             * Registers an agent type, adding one instance of it to the roster
+             */
+            template<typename T>
+            void registerAgent() {
+                add(new T(), &createAgent<T>);
+            }
+
+            /**
+             * Creates a new instance of the named agent, which the caller owns.
+             * Used when several matches need independent agent state
+             */
+            IRobotAgent* spawn(const std::string& name) const;
+
             /**
              * Retrieves a robot agent by index in the roster
              */
@@ -0,0 +1,161 @@
+#ifndef SCAN_BUFFER_H
+#define SCAN_BUFFER_H
+
+#include "ExternalBoardSquare.h"
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * @class ScanBuffer
+     * Fixed size, caller owned storage for a board scan
+     *
+     * The squares live in one contiguous N*N block inside the object, so a buffer can
+     * sit on the stack or in a long lived owner and be refilled every turn without
+     * touching the heap. A table of row pointers lets the buffer stand in wherever the
+     * legacy ExternalBoardSquare** view is expected, e.g. IRobotAgent::getMove.
+     */
+    template<int N>
+    class ScanBuffer {
+        public:
+            static const int SIZE = N; // number of rows and columns
+
+            /**
+             * Creates a buffer of empty squares
+             */
+            ScanBuffer() {
+                linkRows();
+            }
+
+            /**
+             * Copies the squares, the row table keeps pointing into this buffer
+             */
+            ScanBuffer(const ScanBuffer& other) {
+                std::copy(&other.cells[0][0], &other.cells[0][0] + N * N, &cells[0][0]);
+                linkRows();
+            }
+
+            /**
+             * Copies the squares of another buffer
+             */
+            ScanBuffer& operator = (const ScanBuffer& other) {
+                std::copy(&other.cells[0][0], &other.cells[0][0] + N * N, &cells[0][0]);
+                return *this;
+            }
+
+            /**
+             * Gets a row of the scan
+             */
+            ExternalBoardSquare* operator[](int row) {return cells[row];}
+            const ExternalBoardSquare* operator[](int row) const {return cells[row];}
+
+            /**
+             * Views the buffer as a jagged array, valid as long as the buffer is
+             */
+            ExternalBoardSquare** rowPointers() {return rows;}
+            operator ExternalBoardSquare**() {return rows;}
+
+        private:
+            ExternalBoardSquare cells[N][N]; // the squares, row major
+            ExternalBoardSquare* rows[N]; // start of every row in cells
+
+            /**
+             * Points the row table at this buffer's rows
+             */
+            void linkRows() {
+                for (int i = 0; i < N; ++i) {
+                    rows[i] = cells[i];
+                }
+            }
+    };
+
+    /**
+     * @class DynamicScanBuffer
+     * Caller owned storage for a scan whose size is only known at run time
+     *
+     * Same contiguous layout and row table as ScanBuffer, on the heap. resize only
+     * allocates when the size changes, so a buffer refilled every turn from the same
+     * board allocates once.
+     */
+    class DynamicScanBuffer {
+        public:
+            /**
+             * Creates an empty buffer
+             */
+            DynamicScanBuffer() : n(0) {}
+
+            /**
+             * Creates a buffer of size * size empty squares
+             */
+            explicit DynamicScanBuffer(int size) : n(0) {
+                resize(size);
+            }
+
+            /**
+             * Copies the squares, the row table keeps pointing into this buffer
+             */
+            DynamicScanBuffer(const DynamicScanBuffer& other) : n(other.n), cells(other.cells) {
+                linkRows();
+            }
+
+            /**
+             * Copies the squares of another buffer
+             */
+            DynamicScanBuffer& operator = (const DynamicScanBuffer& other) {
+                if (this != &other) {
+                    n = other.n;
+                    cells = other.cells;
+                    linkRows();
+                }
+                return *this;
+            }
+
+            /**
+             * Changes the number of rows and columns, squares are reset if it changes
+             */
+            void resize(int size) {
+                if (size != n) {
+                    n = size;
+                    cells.assign(size_t(size) * size, ExternalBoardSquare());
+                    linkRows();
+                }
+            }
+
+            /**
+             * @return number of rows and columns
+             */
+            int size() const {return n;}
+
+            /**
+             * Gets a row of the scan
+             */
+            ExternalBoardSquare* operator[](int row) {return rows[row];}
+            const ExternalBoardSquare* operator[](int row) const {return rows[row];}
+
+            /**
+             * Views the buffer as a jagged array, valid until the buffer is resized
+             */
+            ExternalBoardSquare** rowPointers() {return rows.data();}
+            operator ExternalBoardSquare**() {return rows.data();}
+
+        private:
+            int n; // number of rows and columns
+            std::vector<ExternalBoardSquare> cells; // the squares, row major
+            std::vector<ExternalBoardSquare*> rows; // start of every row in cells
+
+            /**
+             * Points the row table at this buffer's rows
+             */
+            void linkRows() {
+                rows.resize(n);
+                for (int i = 0; i < n; ++i) {
+                    rows[i] = cells.data() + size_t(i) * n;
+                }
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,245 @@
+#include "Tournament.h"
+#include "RobotAgentRoster.h"
+#include "Replay.h"
+#include "LayoutCorpus.h"
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <exception>
+#include <cmath>
+#include <iomanip>
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    /**
+     * Sets up the pairings, every agent plays every other agent as both red and blue
+     */
+    Tournament::Tournament(const Config& config, const std::vector<std::string>& agentNames,
+                           int matchesPerPairing, unsigned threads) :
+        config(config),
+        agents(agentNames),
+        matchesPerPairing(matchesPerPairing),
+        threadCount(threads),
+        masterSeed(config.hasSeed() ? MatchSeed(config.getSeed()) : MatchSeed::random()),
+        concurrentAgents(false),
+        corpus(nullptr) {
+        if (agents.size() < 2) {
+            throw std::invalid_argument("Tournament needs at least two agents");
+        }
+        if (matchesPerPairing <= 0) {
+            throw std::invalid_argument("Tournament needs at least one match per pairing");
+        }
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        for (size_t red = 0; red < agents.size(); ++red) {
+            for (size_t blue = 0; blue < agents.size(); ++blue) {
+                if (red != blue) {
+                    pairings.push_back(std::make_pair(static_cast<int>(red), static_cast<int>(blue)));
+                }
+            }
+        }
+    }
+
+    /**
+     * Checks the corpus has something to play
+     */
+    void Tournament::setLayoutCorpus(const LayoutCorpus* layouts) {
+        if (layouts && layouts->size() == 0) {
+            throw std::invalid_argument("Layout corpus holds no layouts");
+        }
+        corpus = layouts;
+    }
+
+    /**
+     * Plays one match on a board of its own with freshly spawned agents. The match
+     * seed depends only on the master seed and the match index, or on the layout
+     * played, never on scheduling
+     */
+    MatchResult Tournament::playMatch(int matchIndex, AgentWorker* redWorker, AgentWorker* blueWorker) const {
+        const std::pair<int, int>& pairing = pairings[matchIndex / matchesPerPairing];
+        RobotAgentRoster& roster = RobotAgentRoster::getInstance();
+
+        std::unique_ptr<IRobotAgent> redAgent(roster.spawn(agents[pairing.first]));
+        std::unique_ptr<IRobotAgent> blueAgent(roster.spawn(agents[pairing.second]));
+        redAgent->setRobotColor(RobotMoveRequest::RED);
+        blueAgent->setRobotColor(RobotMoveRequest::BLUE);
+
+        std::unique_ptr<GameBoard> board;
+        if (corpus) {
+            board.reset(new GameBoard(config, corpus->at((matchIndex % matchesPerPairing) % corpus->size())));
+        } else {
+            Config matchConfig(config);
+            matchConfig.setSeed(masterSeed.forMatch(matchIndex).value());
+            board.reset(new GameBoard(matchConfig));
+        }
+        Match match(*board, redAgent.get(), blueAgent.get());
+        match.setConcurrentAgents(concurrentAgents);
+        if (redWorker) {
+            match.setWorkers(redWorker, blueWorker);
+        }
+
+        std::ofstream replayOut;
+        std::unique_ptr<ReplayWriter> recorder;
+        if (!replayDirectory.empty()) {
+            std::string fileName = replayDirectory + "/match-" + std::to_string(matchIndex) + ".pbr";
+            replayOut.open(fileName, std::ios::binary);
+            if (!replayOut.is_open()) {
+                throw std::runtime_error("Could not create replay file: " + fileName);
+            }
+            recorder.reset(new ReplayWriter(replayOut));
+            match.setRecorder(recorder.get());
+        }
+        return match.play();
+    }
+
+    /**
+     * Claims matches from the shared counter until all of them have been played. The
+     * agent workers, if the matches need any, are started once for all of them
+     */
+    void Tournament::worker(std::atomic<int>& nextMatch) {
+        std::unique_ptr<AgentWorker> redWorker;
+        std::unique_ptr<AgentWorker> blueWorker;
+        if (concurrentAgents || config.getMoveTimeLimit() > 0) {
+            redWorker.reset(new AgentWorker());
+            blueWorker.reset(new AgentWorker());
+        }
+        int total = static_cast<int>(results.size());
+        for (int index = nextMatch++; index < total; index = nextMatch++) {
+            results[index] = playMatch(index, redWorker.get(), blueWorker.get());
+        }
+    }
+
+    /**
+     * Plays every match on the worker pool
+     */
+    void Tournament::run() {
+        results.assign(pairings.size() * matchesPerPairing, MatchResult());
+
+        std::atomic<int> nextMatch(0);
+        std::exception_ptr failure;
+        std::mutex failureLock;
+        std::vector<std::thread> pool;
+
+        for (unsigned i = 0; i < threadCount; ++i) {
+            pool.push_back(std::thread([this, &nextMatch, &failure, &failureLock]() {
+                try {
+                    worker(nextMatch);
+                } catch (...) {
+                    std::lock_guard<std::mutex> guard(failureLock);
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                    // Stop the other workers from claiming more matches
+                    nextMatch = static_cast<int>(results.size());
+                }
+            }));
+        }
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+
+        aggregate();
+    }
+
+    /**
+     * Summarises a list of scores, sorting it in the process
+     */
+    ScoreStats Tournament::summarize(std::vector<int>& scores) {
+        ScoreStats summary = {0.0, 0.0, 0, 0, 0};
+        if (scores.empty()) {
+            return summary;
+        }
+
+        std::sort(scores.begin(), scores.end());
+        double sum = 0.0;
+        for (int score : scores) {
+            sum += score;
+        }
+        summary.mean = sum / scores.size();
+
+        double squares = 0.0;
+        for (int score : scores) {
+            squares += (score - summary.mean) * (score - summary.mean);
+        }
+        summary.stddev = std::sqrt(squares / scores.size());
+        summary.min = scores.front();
+        summary.median = scores[scores.size() / 2];
+        summary.max = scores.back();
+        return summary;
+    }
+
+    /**
+     * Builds one summary per pairing from the individual match results
+     */
+    void Tournament::aggregate() {
+        stats.clear();
+        std::vector<int> redScores, blueScores;
+
+        for (size_t p = 0; p < pairings.size(); ++p) {
+            PairingStats pairing = PairingStats();
+            pairing.redAgent = agents[pairings[p].first];
+            pairing.blueAgent = agents[pairings[p].second];
+            pairing.matches = matchesPerPairing;
+
+            redScores.clear();
+            blueScores.clear();
+            for (int m = 0; m < matchesPerPairing; ++m) {
+                const MatchResult& result = results[p * matchesPerPairing + m];
+                switch (result.outcome()) {
+                    case MatchResult::RED_WIN: pairing.redWins++; break;
+                    case MatchResult::BLUE_WIN: pairing.blueWins++; break;
+                    case MatchResult::TIE: pairing.ties++; break;
+                }
+                if (result.endReason == MatchResult::INVALID_MOVE) pairing.invalidMoveEnds++;
+                if (result.endReason == MatchResult::COLLISION) pairing.collisionEnds++;
+                pairing.redTimeouts += result.redTimeouts;
+                pairing.blueTimeouts += result.blueTimeouts;
+                redScores.push_back(result.redScore);
+                blueScores.push_back(result.blueScore);
+            }
+
+            pairing.redScore = summarize(redScores);
+            pairing.blueScore = summarize(blueScores);
+            stats.push_back(pairing);
+        }
+    }
+
+    /**
+     * Prints one line per pairing with win/loss/tie counts and score distributions
+     */
+    void Tournament::printReport(std::ostream& out) const {
+        out << std::left << std::setw(14) << "Red" << std::setw(14) << "Blue"
+            << std::right << std::setw(7) << "Games" << std::setw(7) << "RedW"
+            << std::setw(7) << "BlueW" << std::setw(7) << "Ties"
+            << std::setw(9) << "Invalid" << std::setw(9) << "Collide"
+            << std::setw(9) << "RedTO" << std::setw(9) << "BlueTO"
+            << "   Red score (mean/sd/min/med/max)   Blue score (mean/sd/min/med/max)\n";
+
+        for (const PairingStats& pairing : stats) {
+            out << std::left << std::setw(14) << pairing.redAgent << std::setw(14) << pairing.blueAgent
+                << std::right << std::setw(7) << pairing.matches << std::setw(7) << pairing.redWins
+                << std::setw(7) << pairing.blueWins << std::setw(7) << pairing.ties
+                << std::setw(9) << pairing.invalidMoveEnds << std::setw(9) << pairing.collisionEnds
+                << std::setw(9) << pairing.redTimeouts << std::setw(9) << pairing.blueTimeouts
+                << std::fixed << std::setprecision(1);
+
+            const ScoreStats* sides[] = {&pairing.redScore, &pairing.blueScore};
+            for (const ScoreStats* side : sides) {
+                out << "   " << std::setw(6) << side->mean << std::setw(6) << side->stddev
+                    << std::setw(5) << side->min << std::setw(5) << side->median
+                    << std::setw(5) << side->max << "         ";
+            }
+            out << "\n";
+        }
+    }
+}
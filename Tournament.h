@@ -0,0 +1,158 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "Config.h"
+#include "Match.h"
+#include "MatchSeed.h"
+#include <string>
+#include <vector>
+#include <ostream>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    class LayoutCorpus;
+
+    /**
+     * @struct Summary of one side's scores over a set of matches
+     */
+    struct ScoreStats {
+        double mean;
+        double stddev;
+        int min;
+        int median;
+        int max;
+    };
+
+    /**
+     * @struct Aggregated results for one red agent against one blue agent
+     */
+    struct PairingStats {
+        std::string redAgent;
+        std::string blueAgent;
+        int matches;
+        int redWins;
+        int blueWins;
+        int ties;
+        int invalidMoveEnds; // matches cut short by a rejected move
+        int collisionEnds; // matches cut short by a robot collision
+        int redTimeouts; // red moves lost to the move time limit, over all matches
+        int blueTimeouts; // blue moves lost to the move time limit, over all matches
+        ScoreStats redScore;
+        ScoreStats blueScore;
+    };
+
+    /**
+     * @class Tournament
+     * Plays a headless round robin between robot agents from the roster
+     *
+     * Every ordered pair of distinct agents plays a fixed number of matches, so each
+     * agent gets to play as both red and blue. Matches are spread over a pool of worker
+     * threads; each match gets its own board and freshly spawned agents, so workers
+     * share nothing but the read-only configuration. When agents think on threads of
+     * their own, every worker thread keeps one pair of AgentWorkers for all its matches.
+     */
+    class Tournament {
+        public:
+            /**
+             * Sets up a tournament
+             * @param config Board configuration used for every match, its seed (or a random
+             *               one) is the master seed every match seed is derived from
+             * @param agentNames Names of the roster agents taking part
+             * @param matchesPerPairing Number of matches for every red/blue pairing
+             * @param threads Number of worker threads, 0 to use every core
+             */
+            Tournament(const Config& config, const std::vector<std::string>& agentNames,
+                       int matchesPerPairing, unsigned threads = 0);
+
+            /**
+             * Plays every match and aggregates the results
+             */
+            void run();
+
+            /**
+             * Gets the aggregated results, one entry per pairing
+             */
+            const std::vector<PairingStats>& getResults() const {return stats;}
+
+            /**
+             * Gets the raw result of every match, grouped by pairing
+             */
+            const std::vector<MatchResult>& getMatchResults() const {return results;}
+
+            /**
+             * @return number of worker threads used
+             */
+            unsigned getThreadCount() const {return threadCount;}
+
+            /**
+             * @return the master seed, rerunning with it reproduces every match
+             */
+            uint64_t getSeed() const {return masterSeed.value();}
+
+            /**
+             * Records every match as a replay log named match-<index>.pbr in a directory,
+             * which has to exist. An empty name turns recording off
+             */
+            void setReplayDirectory(const std::string& directory) {replayDirectory = directory;}
+
+            /**
+             * Lets the two agents of every match compute their moves concurrently. Only
+             * pays off for agents that search heavily, since matches already run in parallel
+             */
+            void setConcurrentAgents(bool enabled) {concurrentAgents = enabled;}
+
+            /**
+             * Starts matches from stored layouts instead of generating boards. The n-th
+             * match of every pairing plays layout n, wrapping around the corpus, so all
+             * pairings see the same maps. The corpus is not owned
+             * @throws std::invalid_argument if the corpus is empty
+             */
+            void setLayoutCorpus(const LayoutCorpus* layouts);
+
+            /**
+             * Prints a table of the aggregated results
+             */
+            void printReport(std::ostream& out) const;
+
+        private:
+            Config config; // configuration copied into every board
+            std::vector<std::string> agents; // agents taking part
+            int matchesPerPairing; // matches played by every pairing
+            unsigned threadCount; // size of the worker pool
+            MatchSeed masterSeed; // seed of the whole tournament
+            std::string replayDirectory; // where match replays go, empty for none
+            bool concurrentAgents; // agents of a match think at the same time
+            const LayoutCorpus* corpus; // stored layouts to play, null to generate boards
+            std::vector<std::pair<int, int>> pairings; // red/blue agent indices
+            std::vector<MatchResult> results; // one slot per match
+            std::vector<PairingStats> stats; // one entry per pairing
+
+            /**
+             * Plays a single match, identified by its index in the results
+             * @param redWorker Worker the red agent thinks on, null to call it directly
+             * @param blueWorker Worker the blue agent thinks on, null with redWorker
+             */
+            MatchResult playMatch(int matchIndex, AgentWorker* redWorker, AgentWorker* blueWorker) const;
+
+            /**
+             * Worker loop, plays matches until none are left
+             */
+            void worker(std::atomic<int>& nextMatch);
+
+            /**
+             * Builds the pairing summaries from the match results
+             */
+            void aggregate();
+
+            /**
+             * Summarises a list of scores
+             */
+            static ScoreStats summarize(std::vector<int>& scores);
+    };
+}
+
+#endif
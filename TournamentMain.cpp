@@ -0,0 +1,135 @@
+// TournamentMain.cpp
+#include "Tournament.h"
+#include "LayoutCorpus.h"
+#include "RobotAgentRoster.h"
+#include "LazyRobot.h"
+#include "RandomRobot.h"
+#include "AntiRandom.h"
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+
+    /**
+     * Prints command line usage
+     */
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program
+                  << " <board_config_file> [--matches=N] [--threads=N] [--seed=N]\n"
+                  << "       [--replays=DIR] [--concurrent] [--maps=FILE] [agent ...]\n"
+                  << "Plays N matches (default 100) for every red/blue pairing of the given\n"
+                  << "agents, or of every registered agent when none are named. The same seed\n"
+                  << "replays the same tournament. With --replays every match is recorded to\n"
+                  << "DIR/match-<index>.pbr for paintbots-replay. --concurrent lets both agents\n"
+                  << "of a match compute their moves at the same time. --maps plays the layouts\n"
+                  << "of a paintbots-mapgen corpus, the same ones for every pairing.\n";
+    }
+
+    /**
+     * Parses the value of a --name=value option, returns false if arg is not that option
+     */
+    bool parseOption(const std::string& arg, const std::string& name, int& value) {
+        std::string prefix = "--" + name + "=";
+        if (arg.compare(0, prefix.size(), prefix) != 0) {
+            return false;
+        }
+        value = std::stoi(arg.substr(prefix.size()));
+        if (value < 0) {
+            throw std::invalid_argument("--" + name + " must not be negative");
+        }
+        return true;
+    }
+}
+
+// Main function
+int main(int argc, char* argv[]) {
+    using namespace Paintbots;
+
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        int matches = 100;
+        int threads = 0;
+        std::string seed;
+        std::string replayDirectory;
+        std::string mapFile;
+        bool concurrent = false;
+        std::vector<std::string> agentNames;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (parseOption(arg, "matches", matches) || parseOption(arg, "threads", threads)) {
+                continue;
+            }
+            if (arg.compare(0, 7, "--seed=") == 0) {
+                seed = arg.substr(7);
+                continue;
+            }
+            if (arg.compare(0, 10, "--replays=") == 0) {
+                replayDirectory = arg.substr(10);
+                continue;
+            }
+            if (arg.compare(0, 7, "--maps=") == 0) {
+                mapFile = arg.substr(7);
+                continue;
+            }
+            if (arg == "--concurrent") {
+                concurrent = true;
+                continue;
+            }
+            if (arg.compare(0, 2, "--") == 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            agentNames.push_back(arg);
+        }
+
+        Config config(argv[1]);
+        if (!seed.empty()) {
+            config.setSeed(std::stoull(seed));
+        }
+
+        RobotAgentRoster& roster = RobotAgentRoster::getInstance();
+        roster.registerAgent<LazyRobot>();
+        roster.registerAgent<RandomRobot>();
+        roster.registerAgent<AntiRandom>();
+        if (agentNames.empty()) {
+            for (size_t i = 0; i < roster.size(); ++i) {
+                agentNames.push_back(roster[static_cast<int>(i)]->getRobotName());
+            }
+        }
+
+        Tournament tournament(config, agentNames, matches, static_cast<unsigned>(threads));
+        tournament.setReplayDirectory(replayDirectory);
+        tournament.setConcurrentAgents(concurrent);
+        std::unique_ptr<LayoutCorpus> corpus;
+        if (!mapFile.empty()) {
+            corpus.reset(new LayoutCorpus(mapFile));
+            tournament.setLayoutCorpus(corpus.get());
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        tournament.run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        tournament.printReport(std::cout);
+        std::cout << "\n" << tournament.getMatchResults().size() << " matches on "
+                  << tournament.getThreadCount() << " threads in " << elapsed.count() << "s, seed "
+                  << tournament.getSeed() << "\n";
+
+        RobotAgentRoster::resetInstance();
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Tournament error: " << e.what() << std::endl;
+        return 1;
+    }
+}
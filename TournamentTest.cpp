@@ -0,0 +1,535 @@
+#include "TournamentTest.h"
+#include "Tournament.h"
+#include "Match.h"
+#include "LayoutCorpus.h"
+#include "RobotAgentRoster.h"
+#include "LazyRobot.h"
+#include "RandomRobot.h"
+#include "AntiRandom.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+
+    namespace {
+
+        /**
+         * @class Agent that thinks for a fixed time and then stays put
+         */
+        class SlowAgent : public IRobotAgent {
+            public:
+                explicit SlowAgent(int delayMs) : delay(delayMs), color(RobotMoveRequest::RED) {}
+
+                std::string getRobotName() override {return "SlowAgent";}
+                std::string getRobotCreator() override {return "TournamentTest";}
+                void setRobotColor(RobotMoveRequest::RobotColor c) override {color = c;}
+
+                RobotMoveRequest* getMove(ExternalBoardSquare** srs, ExternalBoardSquare** lrs) override {
+                    (void)srs;
+                    (void)lrs;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+                    RobotMoveRequest* move = new RobotMoveRequest();
+                    move->robot = color;
+                    move->move = RobotMoveRequest::NONE;
+                    move->shoot = false;
+                    return move;
+                }
+
+            private:
+                int delay;
+                RobotMoveRequest::RobotColor color;
+        };
+
+        /**
+         * @class Agent that asks for the long range scan every move and counts the answers
+         */
+        class ScanningAgent : public IRobotAgent {
+            public:
+                ScanningAgent() : scans(0), color(RobotMoveRequest::RED) {}
+
+                std::string getRobotName() override {return "ScanningAgent";}
+                std::string getRobotCreator() override {return "TournamentTest";}
+                void setRobotColor(RobotMoveRequest::RobotColor c) override {color = c;}
+
+                RobotMoveRequest* getMove(ExternalBoardSquare** srs, ExternalBoardSquare** lrs) override {
+                    (void)srs;
+                    if (lrs) {
+                        ++scans;
+                    }
+                    RobotMoveRequest* move = new RobotMoveRequest();
+                    move->robot = color;
+                    move->move = RobotMoveRequest::NONE;
+                    move->shoot = false;
+                    return move;
+                }
+
+                int scans; // moves that got a long range scan
+
+            private:
+                RobotMoveRequest::RobotColor color;
+        };
+
+        /**
+         * @class Agent written against the pointer getMove that forgets to return a move
+         */
+        class NullAgent : public IRobotAgent {
+            public:
+                std::string getRobotName() override {return "NullAgent";}
+                std::string getRobotCreator() override {return "TournamentTest";}
+                void setRobotColor(RobotMoveRequest::RobotColor c) override {(void)c;}
+
+                RobotMoveRequest* getMove(ExternalBoardSquare** srs, ExternalBoardSquare** lrs) override {
+                    (void)srs;
+                    (void)lrs;
+                    return nullptr;
+                }
+        };
+
+        /**
+         * @class Observer that counts notifications and the kinds they carried
+         */
+        class CountingObserver : public Observer {
+            public:
+                CountingObserver() : updates(0), kinds(0) {}
+
+                void update(Observable* subject) override {(void)subject;}
+                void update(Observable* subject, const BoardChange& change) override {
+                    (void)subject;
+                    ++updates;
+                    kinds |= change.getKinds();
+                }
+
+                int updates; // notifications received
+                unsigned kinds; // every kind seen
+        };
+    }
+
+    void TournamentTest::setUp() {
+        RobotAgentRoster::resetInstance();
+        RobotAgentRoster& roster = RobotAgentRoster::getInstance();
+        roster.registerAgent<LazyRobot>();
+        roster.registerAgent<RandomRobot>();
+        roster.registerAgent<AntiRandom>();
+    }
+
+    void TournamentTest::tearDown() {
+        RobotAgentRoster::resetInstance();
+    }
+
+    /**
+     * @test Testing that a match ends within the move limit with the board's scores
+     */
+    void TournamentTest::testMatchRunsToCompletion() {
+        Config config;
+        GameBoard board(config);
+        RandomRobot red;
+        LazyRobot blue;
+        red.setRobotColor(RobotMoveRequest::RED);
+        blue.setRobotColor(RobotMoveRequest::BLUE);
+
+        Match match(board, &red, &blue);
+        MatchResult result = match.play();
+
+        assert(match.isOver());
+        assert(!match.playTurn());
+        assert(result.turns >= 1 && result.turns <= Match::MAX_MOVES);
+        assert(result.turns == Match::MAX_MOVES || result.endReason != MatchResult::MOVE_LIMIT);
+        assert(result.redScore == board.redScore());
+        assert(result.blueScore == board.blueScore());
+        std::cout << "Match runs to completion test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a match needs both agents
+     */
+    void TournamentTest::testMatchRejectsNullAgent() {
+        GameBoard board;
+        LazyRobot agent;
+        try {
+            Match match(board, &agent, nullptr);
+            assert(false && "Should throw exception for missing agent");
+        } catch (const std::invalid_argument&) {
+            std::cout << "Match null agent test: PASS\n";
+        }
+    }
+
+    /**
+     * @test Testing that the roster hands out new instances on spawn
+     */
+    void TournamentTest::testRosterSpawn() {
+        RobotAgentRoster& roster = RobotAgentRoster::getInstance();
+        std::unique_ptr<IRobotAgent> first(roster.spawn("LazyRobot"));
+        std::unique_ptr<IRobotAgent> second(roster.spawn("LazyRobot"));
+        assert(first && second);
+        assert(first.get() != second.get());
+        assert(first.get() != roster["LazyRobot"]);
+        assert(first->getRobotName() == "LazyRobot");
+
+        try {
+            roster.spawn("NoSuchRobot");
+            assert(false && "Should throw exception for unknown agent");
+        } catch (const std::runtime_error&) {
+        }
+        std::cout << "Roster spawn test: PASS\n";
+    }
+
+    /**
+     * @test Testing that every ordered pairing is played the requested number of times
+     */
+    void TournamentTest::testTournamentPairings() {
+        std::vector<std::string> names;
+        names.push_back("LazyRobot");
+        names.push_back("RandomRobot");
+        names.push_back("BeatRandom");
+
+        Tournament tournament(Config(), names, 4, 3);
+        tournament.run();
+
+        assert(tournament.getThreadCount() == 3);
+        assert(tournament.getMatchResults().size() == 6 * 4);
+        assert(tournament.getResults().size() == 6);
+        for (const PairingStats& pairing : tournament.getResults()) {
+            assert(pairing.redAgent != pairing.blueAgent);
+            assert(pairing.matches == 4);
+            assert(pairing.redWins + pairing.blueWins + pairing.ties == 4);
+            assert(pairing.redScore.min <= pairing.redScore.median);
+            assert(pairing.redScore.median <= pairing.redScore.max);
+            assert(pairing.blueScore.min <= pairing.blueScore.max);
+        }
+        std::cout << "Tournament pairings test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a tournament needs at least two agents
+     */
+    void TournamentTest::testTournamentNeedsTwoAgents() {
+        try {
+            Tournament tournament(Config(), std::vector<std::string>(1, "LazyRobot"), 1);
+            assert(false && "Should throw exception for a single agent");
+        } catch (const std::invalid_argument&) {
+            std::cout << "Tournament agent count test: PASS\n";
+        }
+    }
+
+    /**
+     * @test Testing that the master seed fixes every match, whatever thread plays it
+     */
+    void TournamentTest::testSeededTournament() {
+        std::vector<std::string> names;
+        names.push_back("RandomRobot");
+        names.push_back("BeatRandom");
+        Config config;
+        config.setSeed(2024);
+
+        Tournament first(config, names, 5, 1);
+        Tournament second(config, names, 5, 4);
+        first.run();
+        second.run();
+
+        assert(first.getSeed() == 2024);
+        const std::vector<MatchResult>& a = first.getMatchResults();
+        const std::vector<MatchResult>& b = second.getMatchResults();
+        assert(a.size() == b.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(a[i].seed == b[i].seed);
+            assert(a[i].redScore == b[i].redScore);
+            assert(a[i].blueScore == b[i].blueScore);
+            assert(a[i].turns == b[i].turns);
+            assert(a[i].endReason == b[i].endReason);
+        }
+        assert(a[0].seed != a[1].seed);
+        std::cout << "Seeded tournament test: PASS\n";
+    }
+
+    /**
+     * @test Testing that a slow agent forfeits its moves while a fast one keeps playing
+     */
+    void TournamentTest::testMoveTimeLimit() {
+        Config config;
+        config.setSeed(8);
+        config.setMoveTimeLimit(2000);
+        GameBoard board(config);
+        SlowAgent red(20);
+        LazyRobot blue;
+        red.setRobotColor(RobotMoveRequest::RED);
+        blue.setRobotColor(RobotMoveRequest::BLUE);
+
+        Match match(board, &red, &blue);
+        for (int turn = 0; turn < 10 && match.playTurn(); ++turn) {}
+        MatchResult result = match.getResult();
+        assert(result.redTimeouts == result.turns);
+        assert(result.blueTimeouts == 0);
+        assert(match.getRedTimeouts() == result.redTimeouts);
+
+        config.setMoveTimeLimit(0);
+        GameBoard unlimitedBoard(config);
+        SlowAgent patient(1);
+        patient.setRobotColor(RobotMoveRequest::RED);
+        Match unlimited(unlimitedBoard, &patient, &blue);
+        unlimited.playTurn();
+        assert(unlimited.getRedTimeouts() == 0);
+        std::cout << "Move time limit test: PASS\n";
+    }
+
+    /**
+     * @test Testing that letting the agents think at once changes nothing but timing,
+     * also on workers kept across matches
+     */
+    void TournamentTest::testConcurrentAgents() {
+        Config config;
+        config.setSeed(31);
+        MatchResult results[2];
+        for (int concurrent = 0; concurrent < 2; ++concurrent) {
+            GameBoard board(config);
+            RandomRobot red;
+            AntiRandom blue;
+            red.setRobotColor(RobotMoveRequest::RED);
+            blue.setRobotColor(RobotMoveRequest::BLUE);
+            Match match(board, &red, &blue);
+            match.setConcurrentAgents(concurrent == 1);
+            results[concurrent] = match.play();
+        }
+        assert(results[0].turns == results[1].turns);
+        assert(results[0].redScore == results[1].redScore);
+        assert(results[0].blueScore == results[1].blueScore);
+        assert(results[0].endReason == results[1].endReason);
+
+        // Workers lent by the caller serve match after match, reading the live board or,
+        // under a time limit, a copy of it
+        AgentWorker redWorker;
+        AgentWorker blueWorker;
+        for (int limited = 0; limited < 2; ++limited) {
+            Config lentConfig(config);
+            lentConfig.setMoveTimeLimit(limited == 1 ? 10000000 : 0);
+            for (int game = 0; game < 2; ++game) {
+                GameBoard lentBoard(lentConfig);
+                RandomRobot red;
+                AntiRandom blue;
+                red.setRobotColor(RobotMoveRequest::RED);
+                blue.setRobotColor(RobotMoveRequest::BLUE);
+                Match match(lentBoard, &red, &blue);
+                match.setConcurrentAgents(true);
+                match.setWorkers(&redWorker, &blueWorker);
+                MatchResult lent = match.play();
+                assert(lent.turns == results[0].turns);
+                assert(lent.redScore == results[0].redScore);
+                assert(lent.blueScore == results[0].blueScore);
+                assert(lent.redTimeouts == 0 && lent.blueTimeouts == 0);
+            }
+        }
+
+        // One agent driving both robots falls back to taking turns
+        GameBoard board(config);
+        RandomRobot both;
+        Match shared(board, &both, &both);
+        shared.setConcurrentAgents(true);
+        for (int turn = 0; turn < 10 && shared.playTurn(); ++turn) {}
+        std::cout << "Concurrent agents test: PASS\n";
+    }
+
+    /**
+     * @test Testing that each robot gets LONG_RANGE_LIMIT long range scans per match,
+     * charged only when asked for
+     */
+    void TournamentTest::testLongRangeLimit() {
+        Config config;
+        config.setSeed(12);
+        config.setLongRangeLimit(3);
+        for (int concurrent = 0; concurrent < 2; ++concurrent) {
+            GameBoard board(config);
+            ScanningAgent red;
+            LazyRobot blue;
+            red.setRobotColor(RobotMoveRequest::RED);
+            blue.setRobotColor(RobotMoveRequest::BLUE);
+            Match match(board, &red, &blue);
+            match.setConcurrentAgents(concurrent == 1);
+            for (int turn = 0; turn < 10 && match.playTurn(); ++turn) {}
+            assert(red.scans == 3);
+            assert(match.getLongRangeScansLeft(RobotMoveRequest::RED) == 0);
+            assert(match.getLongRangeScansLeft(RobotMoveRequest::BLUE) == 3);
+        }
+
+        // Asking twice in one move costs one scan
+        GameBoard board(config);
+        GameBoard::ShortRangeScan srs;
+        GameBoard::LongRangeScan lrs;
+        BoardView view(board, lrs);
+        AgentContext context(RobotMoveRequest::RED, srs, view, board.getBitBoard(), 1);
+        assert(context.requestLayers() == &board.getBitBoard());
+        assert(context.requestLongRangeView() == &view);
+        assert(context.requestLongRangeScan() != nullptr);
+        assert(context.longRangeScansLeft() == 0);
+        AgentContext spent(RobotMoveRequest::RED, srs, view, board.getBitBoard(), 0);
+        assert(spent.requestLongRangeScan() == nullptr);
+        assert(!spent.usedLongRangeScan());
+
+        // Without scans left the paint counts of the whole board are out of reach too
+        assert(spent.requestLayers() == nullptr);
+        assert(!spent.usedLongRangeScan());
+        RandomRobot random;
+        random.setRobotColor(RobotMoveRequest::RED);
+        random.nextMove(spent);
+        assert(!spent.usedLongRangeScan());
+        AgentContext fresh(RobotMoveRequest::RED, srs, view, board.getBitBoard(), 1);
+        random.nextMove(fresh);
+        assert(fresh.longRangeScansLeft() == 0);
+
+        // Agents counting territory keep the count for a while instead of a scan a move
+        config.setLongRangeLimit(5);
+        GameBoard counted(config);
+        RandomRobot countingRed;
+        AntiRandom countingBlue;
+        countingRed.setRobotColor(RobotMoveRequest::RED);
+        countingBlue.setRobotColor(RobotMoveRequest::BLUE);
+        Match countingMatch(counted, &countingRed, &countingBlue);
+        for (int turn = 0; turn < 10 && countingMatch.playTurn(); ++turn) {}
+        assert(countingMatch.getLongRangeScansLeft(RobotMoveRequest::RED) == 4);
+        assert(countingMatch.getLongRangeScansLeft(RobotMoveRequest::BLUE) == 4);
+        std::cout << "Long range limit test: PASS\n";
+    }
+
+    /**
+     * @test Testing that with a layout corpus every pairing plays the same maps
+     */
+    void TournamentTest::testLayoutCorpus() {
+        {
+            std::ofstream out("tournament.pblc", std::ios::binary);
+            LayoutCorpus::writeHeader(out, 2);
+            Config config;
+            for (uint64_t seed = 70; seed < 72; ++seed) {
+                config.setSeed(seed);
+                LayoutCorpus::writeLayout(out, GameBoard(config));
+            }
+        }
+
+        {
+            LayoutCorpus corpus("tournament.pblc");
+            std::vector<std::string> names = {"LazyRobot", "RandomRobot"};
+            Tournament tournament(Config(), names, 3, 2);
+            tournament.setLayoutCorpus(&corpus);
+            tournament.run();
+            const std::vector<MatchResult>& results = tournament.getMatchResults();
+            assert(results.size() == 6);
+            for (size_t i = 0; i < results.size(); ++i) {
+                assert(results[i].seed == corpus.at((i % 3) % 2).seed);
+            }
+        }
+        std::remove("tournament.pblc");
+        std::cout << "Layout corpus test: PASS\n";
+    }
+
+    /**
+     * @test Testing that observers hear about each turn once, with both robots' moves
+     */
+    void TournamentTest::testTurnNotifications() {
+        Config config;
+        config.setSeed(8);
+        GameBoard board(config);
+        CountingObserver observer;
+        board.addObserver(&observer);
+        ScanningAgent red;
+        ScanningAgent blue;
+        red.setRobotColor(RobotMoveRequest::RED);
+        blue.setRobotColor(RobotMoveRequest::BLUE);
+
+        Match match(board, &red, &blue);
+        for (int turn = 1; turn <= 5; ++turn) {
+            assert(match.playTurn());
+            assert(observer.updates == turn);
+        }
+        assert(observer.kinds == BoardChange::ROBOT_IDLE);
+        board.removeObserver(&observer);
+        std::cout << "Turn notifications test: PASS\n";
+    }
+
+    /**
+     * @test Testing that agents with the pointer getMove still play through nextMove
+     */
+    void TournamentTest::testLegacyMoveAdapter() {
+        Config config;
+        config.setSeed(9);
+        GameBoard board(config);
+        LazyRobot lazy;
+        lazy.setRobotColor(RobotMoveRequest::RED);
+        GameBoard::ShortRangeScan srs;
+        GameBoard::LongRangeScan lrs;
+        board.getShortRangeScan(RobotMoveRequest::RED, srs);
+        BoardView view(board, lrs);
+        AgentContext context(RobotMoveRequest::RED, srs, view, board.getBitBoard(), 0);
+
+        // The built in agents only implement nextMove, the legacy overloads refuse
+        lazy.setSeed(9);
+        RobotMoveRequest byValue = lazy.nextMove(context);
+        assert(byValue.robot == RobotMoveRequest::RED);
+        IRobotAgent& agent = lazy;
+        bool threw = false;
+        try {
+            std::unique_ptr<RobotMoveRequest> legacy(agent.getMove(context));
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+
+        // Legacy agents are adapted by the default nextMove, without a scan once the
+        // budget is spent
+        ScanningAgent scanning;
+        scanning.setRobotColor(RobotMoveRequest::RED);
+        RobotMoveRequest adapted = scanning.nextMove(context);
+        assert(adapted.robot == RobotMoveRequest::RED);
+        assert(adapted.move == RobotMoveRequest::NONE);
+        assert(scanning.scans == 0);
+
+        NullAgent broken;
+        threw = false;
+        try {
+            broken.nextMove(context);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        std::cout << "Legacy move adapter test: PASS\n";
+    }
+
+    bool TournamentTest::doTests() {
+        bool allTestsPassed = true;
+        try {
+            std::cout << "-------------------------\n";
+            std::cout << "Tournament unit tests\n";
+            std::cout << "-------------------------\n";
+
+            setUp();
+            testMatchRunsToCompletion();
+            testMatchRejectsNullAgent();
+            testRosterSpawn();
+            testTournamentPairings();
+            testTournamentNeedsTwoAgents();
+            testSeededTournament();
+            testMoveTimeLimit();
+            testConcurrentAgents();
+            testLongRangeLimit();
+            testLayoutCorpus();
+            testTurnNotifications();
+            testLegacyMoveAdapter();
+            tearDown();
+
+        } catch (const std::exception& e) {
+            std::cout << "Test failed with exception: " << e.what() << std::endl;
+            allTestsPassed = false;
+        }
+
+        return allTestsPassed;
+    }
+}
+
+int main() {
+    Paintbots::TournamentTest tester;
+    return tester.doTests() ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#ifndef TOURNAMENT_TEST_H
+#define TOURNAMENT_TEST_H
+
+#include "ITest.h"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Paintbots {
+    class TournamentTest : public ITest {
+        private:
+            /**
+             * Registers the built-in agents with the roster
+             */
+            void setUp();
+
+            /**
+             * Clears the roster
+             */
+            void tearDown();
+
+            /**
+             * Tests that a match plays to completion and reports the board's scores
+             */
+            void testMatchRunsToCompletion();
+
+            /**
+             * Tests that a match refuses missing agents
+             */
+            void testMatchRejectsNullAgent();
+
+            /**
+             * Tests that spawned agents are independent instances
+             */
+            void testRosterSpawn();
+
+            /**
+             * Tests that every ordered pairing plays the requested number of matches
+             */
+            void testTournamentPairings();
+
+            /**
+             * Tests that a tournament needs at least two agents
+             */
+            void testTournamentNeedsTwoAgents();
+
+            /**
+             * Tests that a seeded tournament replays match for match
+             */
+            void testSeededTournament();
+
+            /**
+             * Tests that agents over the move time limit lose their moves
+             */
+            void testMoveTimeLimit();
+
+            /**
+             * Tests that concurrent agents play exactly the same match as sequential ones,
+             * on workers of their own or lent for several matches
+             */
+            void testConcurrentAgents();
+
+            /**
+             * Tests that long range scans are rationed by LONG_RANGE_LIMIT
+             */
+            void testLongRangeLimit();
+
+            /**
+             * Tests that a layout corpus gives every pairing the same maps
+             */
+            void testLayoutCorpus();
+
+            /**
+             * Tests that observers are notified once per turn
+             */
+            void testTurnNotifications();
+
+            /**
+             * Tests that agents returning moves by pointer are adapted to nextMove
+             */
+            void testLegacyMoveAdapter();
+
+        public:
+            bool doTests() override;
+    };
+}
+
+#endif